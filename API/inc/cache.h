@@ -0,0 +1,66 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+namespace LX::API::Cache
+{
+	// Version of the binary layout of the cache entries
+	// Bump this whenever the tokens or AST nodes change shape
+	constexpr unsigned int FORMAT_VERSION = 6;
+
+	/*
+	* @brief Hashes the source code together with the compiler version
+	* The result is used as the key (and file name) of the cache entry
+	*/
+	unsigned long long hashSource(const std::string& source);
+
+	/*
+	* @brief Loads the tokens and AST of a previously lexed and parsed source
+	*
+	* @return False if there is no valid entry for the key (the caller should then lex and parse as normal)
+	*/
+	bool load(const std::string& cacheDir, unsigned long long key, std::vector<LX::Lexer::Token>& tokens, LX::Parser::FileAST& AST);
+
+	/*
+	* @brief Writes the tokens and AST of a source to the cache
+	* Failing to write the entry is not an error as the cache is only an optimization
+	*/
+	void store(const std::string& cacheDir, unsigned long long key, const std::vector<LX::Lexer::Token>& tokens, const LX::Parser::FileAST& AST);
+}
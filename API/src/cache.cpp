@@ -0,0 +1,715 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <cache.h>
+
+#include <common.h>
+
+// Layout of a cache entry (all values are stored in the native byte order)
+//
+// - Header (fixed size, see below)
+// - String table: every unique string used by the tokens and the AST, stored back to back
+// - Token records: one fixed size record per token pointing into the string table
+// - AST stream: the functions and their nodes written in pre-order
+//
+// Nothing in the entry stores a pointer, only offsets, so the whole file can be read
+// (or mapped) in one go and walked in place
+
+namespace LX::API::Cache
+{
+	// Marks an empty std::unique_ptr<ASTNode> within the AST stream
+	static constexpr std::uint8_t NULL_NODE = 0xFF;
+
+	struct Header
+	{
+		char magic[4] = { 'L', 'X', 'C', '\0' };
+		std::uint32_t formatVersion = FORMAT_VERSION;
+		std::uint64_t key = 0;
+
+		std::uint32_t stringTableSize = 0;
+		std::uint32_t tokenCount = 0;
+		std::uint32_t astSize = 0;
+		std::uint32_t functionCount = 0;
+	};
+
+	struct TokenRecord
+	{
+		std::uint32_t offset;
+		std::uint32_t length;
+		std::uint16_t type;
+		std::uint16_t padding;
+	};
+
+	// Builds the sections of an entry in memory before they are written to disk
+	class Writer
+	{
+		private:
+			// Stops the same string being stored multiple times
+			std::unordered_map<std::string, std::uint32_t> interned;
+
+		public:
+			std::string strings;
+			std::string tokens;
+			std::string ast;
+
+			template<typename T>
+			static void put(std::string& section, T value)
+			{
+				section.append(reinterpret_cast<const char*>(&value), sizeof(T));
+			}
+
+			// Adds the string to the string table and writes its location to the section
+			void putString(std::string& section, const std::string& value)
+			{
+				auto [it, inserted] = interned.try_emplace(value, (std::uint32_t)strings.size());
+
+				if (inserted) { strings.append(value); }
+
+				put<std::uint32_t>(section, it->second);
+				put<std::uint32_t>(section, (std::uint32_t)value.size());
+			}
+	};
+
+	// Walks over an entry loaded into memory
+	// Any read past the end of a section means the entry is corrupt
+	class Reader
+	{
+		private:
+			const char* pos;
+			const char* end;
+
+			const char* strings;
+			std::uint32_t stringsSize;
+
+		public:
+			Reader(const char* begin, size_t size, const char* strings, std::uint32_t stringsSize) :
+				pos(begin), end(begin + size), strings(strings), stringsSize(stringsSize)
+			{}
+
+			template<typename T>
+			T get()
+			{
+				if ((size_t)(end - pos) < sizeof(T))
+				{
+					THROW_ERROR("Cache entry is truncated");
+				}
+
+				T value;
+				std::memcpy(&value, pos, sizeof(T));
+				pos += sizeof(T);
+
+				return value;
+			}
+
+			std::string getString()
+			{
+				std::uint32_t offset = get<std::uint32_t>();
+				std::uint32_t length = get<std::uint32_t>();
+
+				if ((std::uint64_t)offset + length > stringsSize)
+				{
+					THROW_ERROR("Cache entry string is out of range");
+				}
+
+				return std::string(strings + offset, length);
+			}
+
+			std::string stringAt(std::uint32_t offset, std::uint32_t length) const
+			{
+				if ((std::uint64_t)offset + length > stringsSize)
+				{
+					THROW_ERROR("Cache entry string is out of range");
+				}
+
+				return std::string(strings + offset, length);
+			}
+	};
+
+	// -- Serialization -- //
+
+	static void writeNode(Writer& w, const LX::Parser::ASTNode* node);
+
+	static void writeBody(Writer& w, const LX::Parser::AST& body)
+	{
+		Writer::put<std::uint32_t>(w.ast, (std::uint32_t)body.size());
+
+		for (const std::unique_ptr<LX::Parser::ASTNode>& node : body)
+		{
+			writeNode(w, node.get());
+		}
+	}
+
+	static void writeNode(Writer& w, const LX::Parser::ASTNode* node)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr)
+		{
+			Writer::put<std::uint8_t>(w.ast, NULL_NODE);
+			return;
+		}
+
+		Writer::put<std::uint8_t>(w.ast, (std::uint8_t)node->type);
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				w.putString(w.ast, static_cast<const Identifier*>(node)->name);
+				return;
+			}
+
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+			{
+				const VariableDeclaration* varDecl = static_cast<const VariableDeclaration*>(node);
+
+				Writer::put<std::uint8_t>(w.ast, varDecl->getFlags());
+				w.putString(w.ast, varDecl->varType.name);
+				w.putString(w.ast, varDecl->name.name);
+				writeNode(w, varDecl->val.get());
+
+				return;
+			}
+
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+			{
+				const DestructuringDeclaration* destructuring = static_cast<const DestructuringDeclaration*>(node);
+
+				Writer::put<std::uint32_t>(w.ast, (std::uint32_t)destructuring->vars.size());
+
+				for (const std::unique_ptr<VariableDeclaration>& var : destructuring->vars)
+				{
+					writeNode(w, var.get());
+				}
+
+				writeNode(w, destructuring->val.get());
+
+				return;
+			}
+
+			case ASTNode::NodeType::ASSIGNMENT:
+			{
+				const Assignment* assignment = static_cast<const Assignment*>(node);
+
+				w.putString(w.ast, assignment->name.name);
+				writeNode(w, assignment->val.get());
+
+				return;
+			}
+
+			case ASTNode::NodeType::OPERATION:
+			{
+				const Operation* operation = static_cast<const Operation*>(node);
+
+				Writer::put<std::uint16_t>(w.ast, (std::uint16_t)operation->op);
+				writeNode(w, operation->lhs.get());
+				writeNode(w, operation->rhs.get());
+
+				return;
+			}
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				const UnaryOperation* unaryOperation = static_cast<const UnaryOperation*>(node);
+
+				Writer::put<std::uint16_t>(w.ast, (std::uint16_t)unaryOperation->op);
+				Writer::put<std::uint8_t>(w.ast, (std::uint8_t)unaryOperation->side);
+				writeNode(w, unaryOperation->val.get());
+
+				return;
+			}
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				const FunctionCall* functionCall = static_cast<const FunctionCall*>(node);
+
+				Writer::put<std::uint8_t>(w.ast, functionCall->getFlags());
+				w.putString(w.ast, functionCall->funcName.name);
+				writeBody(w, functionCall->args);
+
+				return;
+			}
+
+			case ASTNode::NodeType::STRING_LITERAL:
+			{
+				w.putString(w.ast, static_cast<const StringLiteral*>(node)->value);
+				return;
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+			{
+				writeNode(w, static_cast<const BracketedExpression*>(node)->expr.get());
+				return;
+			}
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+			{
+				writeBody(w, static_cast<const TupleExpression*>(node)->values);
+				return;
+			}
+
+			case ASTNode::NodeType::IF_STATEMENT:
+			{
+				const IfStatement* ifStatement = static_cast<const IfStatement*>(node);
+
+				Writer::put<std::uint8_t>(w.ast, (std::uint8_t)ifStatement->type);
+				writeNode(w, ifStatement->condition.get());
+				writeBody(w, ifStatement->body);
+				writeNode(w, ifStatement->next.get());
+
+				return;
+			}
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				const LoopStatement* loopStatement = static_cast<const LoopStatement*>(node);
+
+				Writer::put<std::uint8_t>(w.ast, (std::uint8_t)loopStatement->loopType);
+				writeNode(w, loopStatement->init.get());
+				writeNode(w, loopStatement->condition.get());
+				writeNode(w, loopStatement->step.get());
+				writeBody(w, loopStatement->body);
+
+				return;
+			}
+
+			case ASTNode::NodeType::JUMP_STATEMENT:
+			{
+				Writer::put<std::uint8_t>(w.ast, (std::uint8_t)static_cast<const JumpStatement*>(node)->jumpType);
+				return;
+			}
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+			{
+				writeNode(w, static_cast<const ReturnStatement*>(node)->expr.get());
+				return;
+			}
+
+			default:
+			{
+				THROW_ERROR("Cannot cache AST node of type: " + std::to_string((int)node->type));
+			}
+		}
+	}
+
+	// -- Deserialization -- //
+
+	static std::unique_ptr<LX::Parser::ASTNode> readNode(Reader& r);
+
+	static void readBody(Reader& r, LX::Parser::AST& body)
+	{
+		std::uint32_t count = r.get<std::uint32_t>();
+		body.reserve(count);
+
+		for (std::uint32_t i = 0; i < count; i++)
+		{
+			body.push_back(readNode(r));
+		}
+	}
+
+	// Reads a node that must be of a specific type (or empty)
+	template<typename NodeT>
+	static std::unique_ptr<NodeT> readNodeAs(Reader& r, LX::Parser::ASTNode::NodeType type)
+	{
+		std::unique_ptr<LX::Parser::ASTNode> node = readNode(r);
+
+		if (node == nullptr)
+		{
+			return nullptr;
+		}
+
+		if (node->type != type)
+		{
+			THROW_ERROR("Cache entry has a node of the wrong type");
+		}
+
+		return std::unique_ptr<NodeT>(static_cast<NodeT*>(node.release()));
+	}
+
+	static std::unique_ptr<LX::Parser::ASTNode> readNode(Reader& r)
+	{
+		using namespace LX::Parser;
+
+		std::uint8_t tag = r.get<std::uint8_t>();
+
+		if (tag == NULL_NODE)
+		{
+			return nullptr;
+		}
+
+		switch ((ASTNode::NodeType)tag)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				return std::make_unique<Identifier>(r.getString());
+			}
+
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+			{
+				std::unique_ptr<VariableDeclaration> out = std::make_unique<VariableDeclaration>();
+
+				out->setFlags(r.get<std::uint8_t>());
+				out->varType.name = r.getString();
+				out->name.name = r.getString();
+				out->val = readNodeAs<Assignment>(r, ASTNode::NodeType::ASSIGNMENT);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+			{
+				std::unique_ptr<DestructuringDeclaration> out = std::make_unique<DestructuringDeclaration>();
+
+				std::uint32_t count = r.get<std::uint32_t>();
+
+				for (std::uint32_t i = 0; i < count; i++)
+				{
+					out->vars.push_back(readNodeAs<VariableDeclaration>(r, ASTNode::NodeType::VARIABLE_DECLARATION));
+				}
+
+				out->val = readNode(r);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::ASSIGNMENT:
+			{
+				std::unique_ptr<Assignment> out = std::make_unique<Assignment>();
+
+				out->name.name = r.getString();
+				out->val = readNode(r);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::OPERATION:
+			{
+				std::unique_ptr<Operation> out = std::make_unique<Operation>();
+
+				out->op = (LX::Lexer::TokenType)r.get<std::uint16_t>();
+				out->lhs = readNode(r);
+				out->rhs = readNode(r);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				std::unique_ptr<UnaryOperation> out = std::make_unique<UnaryOperation>();
+
+				out->op = (LX::Lexer::TokenType)r.get<std::uint16_t>();
+				out->side = (UnaryOperation::Sided)r.get<std::uint8_t>();
+				out->val = readNode(r);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				std::unique_ptr<FunctionCall> out = std::make_unique<FunctionCall>();
+
+				out->setFlags(r.get<std::uint8_t>());
+				out->funcName.name = r.getString();
+				readBody(r, out->args);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::STRING_LITERAL:
+			{
+				return std::make_unique<StringLiteral>(r.getString());
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+			{
+				std::unique_ptr<BracketedExpression> out = std::make_unique<BracketedExpression>();
+
+				out->expr = readNode(r);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+			{
+				std::unique_ptr<TupleExpression> out = std::make_unique<TupleExpression>();
+
+				readBody(r, out->values);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::IF_STATEMENT:
+			{
+				std::unique_ptr<IfStatement> out = std::make_unique<IfStatement>((IfStatement::IfType)r.get<std::uint8_t>());
+
+				out->condition = readNode(r);
+				readBody(r, out->body);
+				out->next = readNodeAs<IfStatement>(r, ASTNode::NodeType::IF_STATEMENT);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				std::unique_ptr<LoopStatement> out = std::make_unique<LoopStatement>((LoopStatement::LoopType)r.get<std::uint8_t>());
+
+				out->init = readNode(r);
+				out->condition = readNode(r);
+				out->step = readNode(r);
+				readBody(r, out->body);
+
+				return out;
+			}
+
+			case ASTNode::NodeType::JUMP_STATEMENT:
+			{
+				return std::make_unique<JumpStatement>((JumpStatement::JumpType)r.get<std::uint8_t>());
+			}
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+			{
+				std::unique_ptr<ReturnStatement> out = std::make_unique<ReturnStatement>();
+
+				out->expr = readNode(r);
+
+				return out;
+			}
+
+			default:
+			{
+				THROW_ERROR("Cache entry has an unknown node type: " + std::to_string((int)tag));
+			}
+		}
+	}
+
+	// -- Public functions -- //
+
+	unsigned long long hashSource(const std::string& source)
+	{
+		// 64-bit FNV-1a
+		std::uint64_t hash = 0xcbf29ce484222325ull;
+
+		auto mix = [&hash](const char* data, size_t size)
+		{
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= (unsigned char)data[i];
+				hash *= 0x100000001b3ull;
+			}
+		};
+
+		// The version is included so a new compiler never reads entries made by an old one
+		mix(LX_COMPILER_VERSION, sizeof(LX_COMPILER_VERSION));
+		mix(source.data(), source.size());
+
+		return hash;
+	}
+
+	static std::string entryPath(const std::string& cacheDir, unsigned long long key)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.lxc", key);
+
+		return cacheDir + "/" + name;
+	}
+
+	bool load(const std::string& cacheDir, unsigned long long key, std::vector<LX::Lexer::Token>& tokens, LX::Parser::FileAST& AST)
+	{
+		// Reads the whole entry with a single read
+		std::ifstream file(entryPath(cacheDir, key), std::ios::binary | std::ios::ate);
+
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		std::streamsize size = file.tellg();
+
+		if (size < (std::streamsize)sizeof(Header))
+		{
+			return false;
+		}
+
+		std::vector<char> data((size_t)size);
+		file.seekg(0);
+
+		if (!file.read(data.data(), size))
+		{
+			return false;
+		}
+
+		// Validates the header
+		Header header;
+		std::memcpy(&header, data.data(), sizeof(Header));
+
+		if (std::memcmp(header.magic, Header().magic, sizeof(header.magic)) != 0 || header.formatVersion != FORMAT_VERSION || header.key != key)
+		{
+			return false;
+		}
+
+		std::uint64_t expectedSize = sizeof(Header) + (std::uint64_t)header.stringTableSize + (std::uint64_t)header.tokenCount * sizeof(TokenRecord) + header.astSize;
+
+		if (expectedSize != (std::uint64_t)size)
+		{
+			return false;
+		}
+
+		const char* strings = data.data() + sizeof(Header);
+		const char* tokenRecords = strings + header.stringTableSize;
+		const char* astStream = tokenRecords + (size_t)header.tokenCount * sizeof(TokenRecord);
+
+		// Builds into temporaries so a corrupt entry leaves the outputs untouched
+		std::vector<LX::Lexer::Token> loadedTokens;
+		LX::Parser::FileAST loadedAST;
+
+		try
+		{
+			Reader tokenReader(tokenRecords, (size_t)header.tokenCount * sizeof(TokenRecord), strings, header.stringTableSize);
+			loadedTokens.reserve(header.tokenCount);
+
+			for (std::uint32_t i = 0; i < header.tokenCount; i++)
+			{
+				TokenRecord record = tokenReader.get<TokenRecord>();
+				loadedTokens.emplace_back((LX::Lexer::TokenType)record.type, tokenReader.stringAt(record.offset, record.length));
+			}
+
+			Reader astReader(astStream, header.astSize, strings, header.stringTableSize);
+			loadedAST.functions.resize(header.functionCount);
+
+			for (LX::Parser::FunctionDeclaration& func : loadedAST.functions)
+			{
+				func.name.name = astReader.getString();
+
+				std::uint32_t returnCount = astReader.get<std::uint32_t>();
+
+				for (std::uint32_t i = 0; i < returnCount; i++)
+				{
+					func.returnTypes.emplace_back(astReader.getString());
+				}
+
+				readBody(astReader, func.args);
+				readBody(astReader, func.body);
+			}
+		}
+
+		// Corrupt entries are treated as a miss
+		catch (const LX::Debug::Error&)
+		{
+			return false;
+		}
+
+		tokens = std::move(loadedTokens);
+		AST = std::move(loadedAST);
+
+		return true;
+	}
+
+	void store(const std::string& cacheDir, unsigned long long key, const std::vector<LX::Lexer::Token>& tokens, const LX::Parser::FileAST& AST)
+	{
+		Writer w;
+
+		try
+		{
+			// Tokens
+			for (const LX::Lexer::Token& token : tokens)
+			{
+				w.putString(w.tokens, token.value);
+				Writer::put<std::uint16_t>(w.tokens, (std::uint16_t)token.type);
+				Writer::put<std::uint16_t>(w.tokens, 0);
+			}
+
+			// AST
+			for (const LX::Parser::FunctionDeclaration& func : AST.functions)
+			{
+				w.putString(w.ast, func.name.name);
+
+				Writer::put<std::uint32_t>(w.ast, (std::uint32_t)func.returnTypes.size());
+
+				for (const LX::Parser::Identifier& returnType : func.returnTypes)
+				{
+					w.putString(w.ast, returnType.name);
+				}
+
+				writeBody(w, func.args);
+				writeBody(w, func.body);
+			}
+		}
+
+		// Some nodes cannot be cached so the source is just lexed and parsed every time
+		catch (const LX::Debug::Error&)
+		{
+			return;
+		}
+
+		Header header;
+		header.key = key;
+		header.stringTableSize = (std::uint32_t)w.strings.size();
+		header.tokenCount = (std::uint32_t)tokens.size();
+		header.astSize = (std::uint32_t)w.ast.size();
+		header.functionCount = (std::uint32_t)AST.functions.size();
+
+		std::error_code ec;
+		std::filesystem::create_directories(cacheDir, ec);
+
+		// Writes to a temporary file first so a half written entry is never read
+		std::string path = entryPath(cacheDir, key);
+		std::string tempPath = path + ".tmp";
+
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+
+			if (!file.is_open())
+			{
+				return;
+			}
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			file.write(w.strings.data(), w.strings.size());
+			file.write(w.tokens.data(), w.tokens.size());
+			file.write(w.ast.data(), w.ast.size());
+
+			if (!file)
+			{
+				file.close();
+				std::filesystem::remove(tempPath, ec);
+				return;
+			}
+		}
+
+		std::filesystem::rename(tempPath, path, ec);
+	}
+}
@@ -41,6 +41,11 @@
 #include <lexer.h>
 #include <parser.h>
 #include <translator.h>
+#include <output.h>
+#include <batch-io.h>
+#include <optimizer.h>
+
+#include <cache.h>
 
 namespace LX::API
 {
@@ -63,9 +68,83 @@ namespace LX::API
 		return buffer.str();
 	}
 
+	// Sources read by prefetchSources that have not been lexed yet (by full path)
+	std::unordered_map<std::string, std::string> prefetchedSources;
+
 	std::unordered_map<int, std::vector<LX::Lexer::Token>> funcTokenMap;
 	std::unordered_map<int, LX::Parser::FileAST> astMap;
 
+	// Output of every file that has been translated
+	LX::Translator::OutputRegistry outputRegistry;
+
+	// How the output is split into .cpp files
+	LX::Translator::OutputOptions outputOptions;
+
+	// Which optimizations are run by optimizeProject
+	LX::Optimizer::Options optimizerOptions;
+
+	// Cache dir and key of the sources that still need to be parsed (and then stored in the cache)
+	std::unordered_map<int, std::pair<std::string, unsigned long long>> cacheKeyMap;
+
+	// Sources whose AST was loaded from the cache so do not need to be parsed
+	std::set<int> cachedIDs;
+
+	static std::string getCacheDir(const char* folder)
+	{
+		return std::string(folder) + "/build/lx-cache";
+	}
+
+	// Reads all the source files of a directory in one batch before they are lexed
+	// Files that fail to be read here are read again (and the error reported) by lexSource
+	DLL_FUNC bool prefetchSources(const char* folder, const char* srcDir, const char** filenames, int count)
+	{
+		try
+		{
+			std::vector<LX::Translator::FileRead> files(count);
+
+			for (int i = 0; i < count; i++)
+			{
+				files[i].path = std::string(folder) + "/" + std::string(srcDir) + "/" + std::string(filenames[i]);
+			}
+
+			LX::Translator::readFiles(files);
+
+			for (LX::Translator::FileRead& file : files)
+			{
+				if (file.success == false) { continue; }
+
+				// Matches the line endings of the text mode std::ifstream used by readFileToString ("\r\n" becomes "\n")
+				std::string& contents = file.contents;
+				size_t length = 0;
+
+				for (size_t i = 0; i < contents.size(); i++)
+				{
+					if (contents[i] != '\r' || i + 1 == contents.size() || contents[i + 1] != '\n') { contents[length++] = contents[i]; }
+				}
+
+				contents.resize(length);
+
+				prefetchedSources[file.path] = std::move(file.contents);
+			}
+
+			return true;
+		}
+
+		// C++ error handling
+		catch (const std::exception& e)
+		{
+			std::cerr << e.what() << std::endl;
+			return false;
+		}
+
+		// LX error handling
+		catch (const LX::Debug::Error& e)
+		{
+			e.display();
+			return false;
+		}
+	}
+
 	// Lexer function call
 	DLL_FUNC int lexSource(const char* folder, const char* srcDir, const char* filename, bool debug)
 	{
@@ -74,14 +153,38 @@ namespace LX::API
 		{
 			// Gets the full path of the file
 			std::string fullPath = std::string(folder) + "/" + std::string(srcDir) + "/" + std::string(filename);
-			std::string source = readFileToString(fullPath);
+			std::string source;
 
-			// Creates a lexer object
-			LX::Lexer::Lexer lexer(source, debug);
+			// Uses the prefetched version of the file if there is one
+			if (auto it = prefetchedSources.find(fullPath); it != prefetchedSources.end())
+			{
+				source = std::move(it->second);
+				prefetchedSources.erase(it);
+			}
+
+			else
+			{
+				source = readFileToString(fullPath);
+			}
 
 			// Gets the next id
 			int id = (int)funcTokenMap.size();
 
+			// Checks the cache for an unchanged version of the source
+			// The debug CLI needs the lexer sections so the cache is skipped when debugging
+			unsigned long long key = LX::API::Cache::hashSource(source);
+
+			if (debug == false && LX::API::Cache::load(getCacheDir(folder), key, funcTokenMap[id], astMap[id]))
+			{
+				cachedIDs.insert(id);
+				return id;
+			}
+
+			cacheKeyMap[id] = { getCacheDir(folder), key };
+
+			// Creates a lexer object
+			LX::Lexer::Lexer lexer(source, debug);
+
 			// Moves the tokens to the map from the lexer
 			// Probably should optimize this
 			funcTokenMap[id] = lexer.getFunctionTokens();
@@ -158,10 +261,22 @@ namespace LX::API
 		// Main parser function call
 		try
 		{
+			// The AST was already loaded from the cache
+			if (cachedIDs.find(id) != cachedIDs.end())
+			{
+				return true;
+			}
+
 			LX::Parser::Parser parser;
 
 			parser.parse(funcTokenMap[id], astMap[id]);
 
+			// Stores the tokens and AST so the next build can skip lexing and parsing this source
+			if (auto it = cacheKeyMap.find(id); it != cacheKeyMap.end())
+			{
+				LX::API::Cache::store(it->second.first, it->second.second, funcTokenMap[id], astMap[id]);
+			}
+
 			if (debug == true)
 			{
 				for (LX::Parser::FunctionDeclaration& func : astMap[id].functions)
@@ -188,19 +303,70 @@ namespace LX::API
 		}
 	}
 
-	// Translator function call
-	DLL_FUNC bool translateAST(const char* folder, const char* filename, bool debug, int id)
+	// Turns an optimization on or off by name (returns false if there is no optimization with that name)
+	DLL_FUNC bool configureOptimizer(const char* name, bool enabled)
+	{
+		return optimizerOptions.set(name, enabled);
+	}
+
+	// Sets a limit of the optimizer by name (returns false if there is no limit with that name)
+	DLL_FUNC bool configureOptimizerLimit(const char* name, unsigned int value)
+	{
+		return optimizerOptions.setLimit(name, value);
+	}
+
+	// Sets every optimization to the default of a profile ("debug" or "release")
+	DLL_FUNC bool setOptimizationProfile(const char* profile)
+	{
+		return optimizerOptions.setProfile(profile);
+	}
+
+	// Optimizer function call
+	// Runs on every parsed source at once so it has to be called after all the sources are parsed and before any are translated
+	// The cache stores the AST from before it is optimized so changing the optimizations does not need the cache to be cleared
+	// Why each call was or was not inlined is written to build/lx-inlining.txt
+	DLL_FUNC bool optimizeProject(const char* folder, bool debug)
 	{
-		// Main translator function call
 		try
 		{
-			std::string outDir = std::string(folder) + "/build";
+			// Sorted by id so the output is the same every build
+			std::vector<int> ids;
 
-			for (LX::Parser::FunctionDeclaration& func : astMap[id].functions)
+			for (const auto& [id, AST] : astMap)
 			{
-				LX::Translator::Translator translator;
+				ids.push_back(id);
+			}
 
-				translator.assemble(func, outDir, filename);
+			std::sort(ids.begin(), ids.end());
+
+			std::vector<LX::Parser::FileAST*> files;
+
+			for (int id : ids)
+			{
+				files.push_back(&astMap[id]);
+			}
+
+			LX::Optimizer::Report report = LX::Optimizer::optimize(files, optimizerOptions);
+
+			if (optimizerOptions.inlining)
+			{
+				std::ofstream file(std::string(folder) + "/build/lx-inlining.txt", std::ios::trunc);
+
+				for (const std::string& line : report.inlining)
+				{
+					file << line << '\n';
+				}
+			}
+
+			if (debug == true)
+			{
+				for (LX::Parser::FileAST* file : files)
+				{
+					for (LX::Parser::FunctionDeclaration& func : file->functions)
+					{
+						Debug::Log(&func, 0);
+					}
+				}
 			}
 
 			return true;
@@ -221,21 +387,82 @@ namespace LX::API
 		}
 	}
 
+	// Translator function call
+	DLL_FUNC bool translateAST(const char* filename, int id)
+	{
+		// Main translator function call
+		try
+		{
+			// Translates the functions of the file in parallel
+			// They are written to the build folder by writeOutputFiles once every file has been translated
+			LX::Translator::translateFile(astMap[id], outputRegistry, filename);
+
+			return true;
+		}
+
+		// C++ error handling
+		catch (const std::exception& e)
+		{
+			std::cerr << e.what() << std::endl;
+			return false;
+		}
+
+		// LX error handling
+		catch (const LX::Debug::Error& e)
+		{
+			e.display();
+			return false;
+		}
+	}
+
+	// Sets up a unity build (all 0 means every function gets its own .cpp file)
+	DLL_FUNC void setUnityBuild(unsigned int units, unsigned int maxFunctions, unsigned int maxBytes)
+	{
+		outputOptions.unityUnits = units;
+		outputOptions.unityMaxFunctions = maxFunctions;
+		outputOptions.unityMaxBytes = maxBytes;
+	}
+
+	// Writes the translated functions to .cpp files
+	DLL_FUNC bool writeOutputFiles(const char* folder)
+	{
+		try
+		{
+			outputRegistry.write(std::string(folder) + "/build", outputOptions);
+
+			return true;
+		}
+
+		// C++ error handling
+		catch (const std::exception& e)
+		{
+			std::cerr << e.what() << std::endl;
+			return false;
+		}
+
+		// LX error handling
+		catch (const LX::Debug::Error& e)
+		{
+			e.display();
+			return false;
+		}
+	}
+
 	// Create header file
+	// The translated files only include the declaration headers they need
+	// functions.h includes all of them for code outside of the project that calls LX functions
 	DLL_FUNC bool CreateHeaderFile(const char* folder)
 	{
 		try
 		{
-			std::ofstream headerFile(std::string(folder) + "/build/functions.h");
-
-			headerFile << "#pragma once\n\n";
+			std::string headerFile = "#pragma once\n\n";
 
-			for (std::string& header : LX::Translator::Translator::funcHeaders)
+			for (const std::string& header : outputRegistry.getDeclarationHeaders())
 			{
-				headerFile << header << ";\n";
+				headerFile.append("#include <").append(header).append(">\n");
 			}
 
-			headerFile.close();
+			LX::Translator::writeIfChanged(std::string(folder) + "/build/functions.h", headerFile);
 
 			return true;
 		}
@@ -64,6 +64,7 @@ namespace LX::Parser
 			{
 				IDENTIFIER,
 				VARIABLE_DECLARATION,
+				DESTRUCTURING_DECLARATION,
 				ASSIGNMENT,
 				OPERATION,
 				UNARY_OPERATION,
@@ -71,8 +72,11 @@ namespace LX::Parser
 				STRING_LITERAL,
 
 				BRACKETED_EXPRESSION,
+				TUPLE_EXPRESSION,
 
 				IF_STATEMENT,
+				LOOP_STATEMENT,
+				JUMP_STATEMENT,
 
 				RETURN_STATEMENT,
 
@@ -140,6 +144,23 @@ namespace LX::Parser
 			FLAG_DEF(Static, 0x08);
 			FLAG_DEF(GuideChild, 0x10);
 			FLAG_DEF(Unsigned, 0x20);
+
+			FLAG_RAW();
+	};
+
+	/*
+	* @brief Represents the declaration of a variable for each value returned by a function with multiple return types
+	* For example: int quotient, int remainder = divide(7, 2)
+	*/
+	class DestructuringDeclaration : public ASTNode
+	{
+		public:
+			// Constructor
+			DestructuringDeclaration() : ASTNode(NodeType::DESTRUCTURING_DECLARATION) {}
+
+			// Contents (the variables have no values of their own)
+			std::vector<std::unique_ptr<VariableDeclaration>> vars;
+			std::unique_ptr<ASTNode> val;
 	};
 
 	/*
@@ -189,6 +210,9 @@ namespace LX::Parser
 			// Constructor
 			FunctionCall() : ASTNode(NodeType::FUNCTION_CALL) {}
 
+			// Flags
+			FLAG_RAW();
+
 			// Name
 			Identifier funcName;
 
@@ -235,6 +259,55 @@ namespace LX::Parser
 			std::unique_ptr<IfStatement> next;
 	};
 
+	/*
+	* @brief Represents a while or for loop in the AST
+	* A for loop can also have a statement run before the loop (init) and one run after each iteration (step)
+	*/
+	class LoopStatement : public ASTNode
+	{
+		public:
+			// Enum for representing the kind of loop
+			enum class LoopType : char
+			{
+				WHILE,
+				FOR
+			};
+
+			// Constructor
+			LoopStatement(LoopType t) : ASTNode(NodeType::LOOP_STATEMENT), loopType(t) {}
+
+			// Parts of the loop header (all of them can be empty in a for loop)
+			std::unique_ptr<ASTNode> init;
+			std::unique_ptr<ASTNode> condition;
+			std::unique_ptr<ASTNode> step;
+
+			// Body
+			std::vector<std::unique_ptr<ASTNode>> body;
+
+			// Type
+			LoopType loopType;
+	};
+
+	/*
+	* @brief Represents a break or continue statement in the AST
+	*/
+	class JumpStatement : public ASTNode
+	{
+		public:
+			// Enum for representing the kind of jump
+			enum class JumpType : char
+			{
+				BREAK,
+				CONTINUE
+			};
+
+			// Constructor
+			JumpStatement(JumpType t) : ASTNode(NodeType::JUMP_STATEMENT), jumpType(t) {}
+
+			// Type
+			JumpType jumpType;
+	};
+
 	class BracketedExpression : public ASTNode
 	{
 		public:
@@ -245,6 +318,19 @@ namespace LX::Parser
 			std::unique_ptr<ASTNode> expr;
 	};
 
+	/*
+	* @brief Represents a list of values separated by commas (such as return a, b)
+	*/
+	class TupleExpression : public ASTNode
+	{
+		public:
+			// Constructor
+			TupleExpression() : ASTNode(NodeType::TUPLE_EXPRESSION) {}
+
+			// Contents
+			std::vector<std::unique_ptr<ASTNode>> values;
+	};
+
 	class ReturnStatement : public ASTNode
 	{
 		public:
@@ -55,9 +55,23 @@ namespace LX::Lexer
 		INT_DEC,
 		STR_DEC,
 
+		// Fixed width types
+		I8_DEC,
+		I16_DEC,
+		I32_DEC,
+		I64_DEC,
+		U8_DEC,
+		U16_DEC,
+		U32_DEC,
+		U64_DEC,
+		F32_DEC,
+		F64_DEC,
+
 		// Var Modifiers //
 
 		CONST,
+		STATIC,
+		REFERENCE, // & (Written after the type)
 
 		// Control flow //
 		// These are not identifiers because thier behavior cannot be changed at compile/runtime //
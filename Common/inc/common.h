@@ -51,4 +51,9 @@
 // Macro headers //
 
 #include <macro/dll.h>
-#include <macro/flag.h>
\ No newline at end of file
+#include <macro/flag.h>
+#include <macro/version.h>
+
+// Threading headers //
+
+#include <thread/parallel.h>
\ No newline at end of file
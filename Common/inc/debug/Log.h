@@ -55,7 +55,19 @@ namespace LX::Debug
 				TOKEN_CASE(TokenType::STRING_LITERAL)
 				TOKEN_CASE(TokenType::INT_DEC)
 				TOKEN_CASE(TokenType::STR_DEC)
+				TOKEN_CASE(TokenType::I8_DEC)
+				TOKEN_CASE(TokenType::I16_DEC)
+				TOKEN_CASE(TokenType::I32_DEC)
+				TOKEN_CASE(TokenType::I64_DEC)
+				TOKEN_CASE(TokenType::U8_DEC)
+				TOKEN_CASE(TokenType::U16_DEC)
+				TOKEN_CASE(TokenType::U32_DEC)
+				TOKEN_CASE(TokenType::U64_DEC)
+				TOKEN_CASE(TokenType::F32_DEC)
+				TOKEN_CASE(TokenType::F64_DEC)
 				TOKEN_CASE(TokenType::CONST)
+				TOKEN_CASE(TokenType::STATIC)
+				TOKEN_CASE(TokenType::REFERENCE)
 				TOKEN_CASE(TokenType::IF)
 				TOKEN_CASE(TokenType::ELIF)
 				TOKEN_CASE(TokenType::ELSE)
@@ -229,6 +241,22 @@ namespace LX::Debug
 				return;
 			}
 
+			case LX::Parser::ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+			{
+				LX::Parser::DestructuringDeclaration* destructuring = static_cast<LX::Parser::DestructuringDeclaration*>(node.get());
+
+				std::cout << std::string(depth, '\t') << "Destructuring Declaration: " << std::endl;
+
+				for (std::unique_ptr<LX::Parser::VariableDeclaration>& var : destructuring->vars)
+				{
+					std::cout << std::string(depth + 1, '\t') << "Variable: type {" << var->varType.name << "} name {" << var->name.name << "}" << std::endl;
+				}
+
+				Log(destructuring->val, depth + 1);
+
+				return;
+			}
+
 			case LX::Parser::ASTNode::NodeType::ASSIGNMENT:
 			{
 				LX::Parser::Assignment* assignment = static_cast<LX::Parser::Assignment*>(node.get());
@@ -294,6 +322,50 @@ namespace LX::Debug
 				return;
 			}
 
+			case LX::Parser::ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				LX::Parser::LoopStatement* loopStatement = static_cast<LX::Parser::LoopStatement*>(node.get());
+
+				std::cout << std::string(depth, '\t') << (loopStatement->loopType == LX::Parser::LoopStatement::LoopType::FOR ? "For Loop: " : "While Loop: ") << std::endl;
+
+				// The parts of the header are optional in a for loop
+				if (loopStatement->init != nullptr)
+				{
+					std::cout << std::string(depth, '\t') << "Init: " << std::endl;
+					Log(loopStatement->init, depth + 1);
+				}
+
+				if (loopStatement->condition != nullptr)
+				{
+					std::cout << std::string(depth, '\t') << "Condition: " << std::endl;
+					Log(loopStatement->condition, depth + 1);
+				}
+
+				if (loopStatement->step != nullptr)
+				{
+					std::cout << std::string(depth, '\t') << "Step: " << std::endl;
+					Log(loopStatement->step, depth + 1);
+				}
+
+				std::cout << std::string(depth, '\t') << "Body: " << std::endl;
+
+				for (std::unique_ptr<LX::Parser::ASTNode>& statement : loopStatement->body)
+				{
+					Log(statement, depth + 1);
+				}
+
+				return;
+			}
+
+			case LX::Parser::ASTNode::NodeType::JUMP_STATEMENT:
+			{
+				LX::Parser::JumpStatement* jumpStatement = static_cast<LX::Parser::JumpStatement*>(node.get());
+
+				std::cout << std::string(depth, '\t') << (jumpStatement->jumpType == LX::Parser::JumpStatement::JumpType::BREAK ? "Break Statement" : "Continue Statement") << std::endl;
+
+				return;
+			}
+
 			case LX::Parser::ASTNode::NodeType::RETURN_STATEMENT:
 			{
 				LX::Parser::ReturnStatement* returnStatement = static_cast<LX::Parser::ReturnStatement*>(node.get());
@@ -316,6 +388,20 @@ namespace LX::Debug
 				return;
 			}
 
+			case LX::Parser::ASTNode::NodeType::TUPLE_EXPRESSION:
+			{
+				LX::Parser::TupleExpression* tuple = static_cast<LX::Parser::TupleExpression*>(node.get());
+
+				std::cout << std::string(depth, '\t') << "Tuple Expression: " << std::endl;
+
+				for (std::unique_ptr<LX::Parser::ASTNode>& value : tuple->values)
+				{
+					Log(value, depth + 1);
+				}
+
+				return;
+			}
+
 			default:
 			{
 				std::cout << std::string(depth, '\t') << "Undefined AST node: " << (int)node->type << std::endl;
@@ -45,4 +45,7 @@ typedef unsigned char Flags;
 #define FLAG_GET(name) inline bool is##name() const { return flags & name##FlagVal; }
 
 // Flag definition macro
-#define FLAG_DEF(name, value) FLAG_VAL(name##FlagVal, value) FLAG_SET(name) FLAG_GET(name)
\ No newline at end of file
+#define FLAG_DEF(name, value) FLAG_VAL(name##FlagVal, value) FLAG_SET(name) FLAG_GET(name)
+
+// Raw access to all the flags at once (used when serializing nodes)
+#define FLAG_RAW() inline Flags getFlags() const { return flags; } inline void setFlags(Flags value) { flags = value; }
\ No newline at end of file
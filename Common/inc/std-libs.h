@@ -39,6 +39,7 @@
 // Standard libraries includes //
 
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <algorithm>
 #include <stdexcept>
@@ -50,4 +51,14 @@
 #include <string>
 #include <fstream>
 #include <sstream>
-#include <set>
\ No newline at end of file
+#include <set>
+#include <map>
+#include <charconv>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
\ No newline at end of file
@@ -0,0 +1,193 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <std-libs.h>
+
+namespace LX::Thread
+{
+	// A single call to parallelFor
+	// Shared between the calling thread and the workers helping with it so workers that start late can still safely check it
+	struct ParallelJob
+	{
+		ParallelJob(size_t count, const std::function<void(size_t)>& func) : count(count), func(func) {}
+
+		const size_t count;
+		const std::function<void(size_t)>& func;
+
+		// Index of the next item to process
+		std::atomic<size_t> next = 0;
+
+		// Set once any item has thrown so the rest are skipped
+		std::atomic<bool> stopped = false;
+
+		// First exception thrown by any of the items
+		std::exception_ptr error = nullptr;
+
+		// Number of items that have been processed (or skipped)
+		size_t finished = 0;
+
+		std::mutex lock;
+		std::condition_variable allFinished;
+
+		// Processes items until there are none left
+		// func is only used for items taken before the last one finishes so it is never used after parallelFor has returned
+		void work()
+		{
+			size_t i;
+
+			while ((i = next.fetch_add(1)) < count)
+			{
+				if (stopped == false)
+				{
+					try
+					{
+						func(i);
+					}
+
+					catch (...)
+					{
+						std::lock_guard<std::mutex> guard(lock);
+
+						if (error == nullptr) { error = std::current_exception(); }
+						stopped = true;
+					}
+				}
+
+				std::lock_guard<std::mutex> guard(lock);
+				if (++finished == count) { allFinished.notify_all(); }
+			}
+		}
+	};
+
+	// Worker threads that are started the first time they are needed and kept for the rest of the program
+	// Creating and joining threads on every call adds up as it is called for every file and optimizer pass
+	class WorkerPool
+	{
+		private:
+			std::mutex lock;
+			std::condition_variable hasJobs;
+
+			// Each entry is a request for one more worker to help with the job
+			std::deque<std::shared_ptr<ParallelJob>> jobs;
+
+			size_t workerCount = 0;
+
+			void run()
+			{
+				while (true)
+				{
+					std::shared_ptr<ParallelJob> job;
+
+					{
+						std::unique_lock<std::mutex> guard(lock);
+						hasJobs.wait(guard, [this]() { return jobs.empty() == false; });
+
+						job = std::move(jobs.front());
+						jobs.pop_front();
+					}
+
+					job->work();
+				}
+			}
+
+		public:
+			WorkerPool()
+			{
+				// hardware_concurrency can return 0 if it is unknown
+				// The thread calling parallelFor also does work so one less worker is needed
+				workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+				// The workers are never joined as the pool lasts until the program exits
+				for (size_t i = 0; i < workerCount; i++) { std::thread(&WorkerPool::run, this).detach(); }
+			}
+
+			inline size_t size() const { return workerCount; }
+
+			// Asks the given number of workers to help with the job
+			inline void submit(const std::shared_ptr<ParallelJob>& job, size_t helpers)
+			{
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					for (size_t i = 0; i < helpers; i++) { jobs.push_back(job); }
+				}
+
+				hasJobs.notify_all();
+			}
+	};
+
+	// Returns the pool shared by every call to parallelFor
+	// It is never destroyed as joining threads while a DLL is unloaded can deadlock
+	inline WorkerPool& workerPool()
+	{
+		static WorkerPool* pool = new WorkerPool();
+		return *pool;
+	}
+
+	/*
+	* @brief Calls func(i) for every i in [0, count) spread across a pool of worker threads
+	* The calling thread also does work so a count of 1 never uses the pool
+	* The calling thread only waits for items that have already been started so parallelFor can be called by func
+	*
+	* @note The first exception thrown by any call is rethrown on the calling thread once all the items have stopped
+	*/
+	inline void parallelFor(size_t count, const std::function<void(size_t)>& func)
+	{
+		if (count == 0) { return; }
+
+		std::shared_ptr<ParallelJob> job = std::make_shared<ParallelJob>(count, func);
+
+		if (count > 1)
+		{
+			WorkerPool& pool = workerPool();
+			pool.submit(job, std::min(pool.size(), count - 1));
+		}
+
+		job->work();
+
+		{
+			std::unique_lock<std::mutex> guard(job->lock);
+			job->allFinished.wait(guard, [&]() { return job->finished == job->count; });
+		}
+
+		if (job->error != nullptr)
+		{
+			std::rethrow_exception(job->error);
+		}
+	}
+}
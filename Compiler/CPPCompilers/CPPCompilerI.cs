@@ -48,6 +48,10 @@ namespace LX
     {
         public string projectDir { get; set; }
 
+        // Function to precompile the header that is included by every translated file
+        // Files compiled afterwards by CompileToObj will use the precompiled version
+        public bool CompilePrecompiledHeader(string headerFile, string sourceFile, out string error);
+
         // Function to compile a .cpp file to a .obj file
         public bool CompileToObj(string fileName, out string error);
 
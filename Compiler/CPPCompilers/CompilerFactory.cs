@@ -83,11 +83,23 @@ namespace LX
                     }
                     res = tempRes;
                     break;
+                case "GCC":
+                case "Clang":
+                    GNU_Compiler gnuRes;
+                    if (GNU_Compiler.Create(buildInfoPath, ref compilerJSON, compilerType == "Clang", out gnuRes, out error))
+                    {
+                        res = null;
+                        return true;
+                    }
+                    res = gnuRes;
+                    break;
                 default:
                     res = null;
                     error = "Invalid Compiler Type: " + compilerType + "\n" +
                             "Valid types are:\n" +
-                            "\tMSVC-22";
+                            "\tMSVC-22\n" +
+                            "\tGCC\n" +
+                            "\tClang";
                     return true;
             }
 
@@ -0,0 +1,198 @@
+﻿// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+// ======================================================================================= //
+
+// Standard Libraries
+using System;
+using System.Diagnostics;
+using System.Text.Json;
+
+// Project namespace
+namespace LX
+{
+    // Class to control GCC (g++) and Clang (clang++)
+    public class GNU_Compiler : CPPCompilerI
+    {
+        public string projectDir { get; set; }
+
+        // Path to the compiler executable (or just its name if it is on the PATH)
+        string compilerLocation;
+
+        // Clang only uses precompiled headers that are passed to it directly
+        // GCC finds them itself when the header is included
+        bool isClang;
+
+        // Path of the precompiled header (null until CompilePrecompiledHeader has been called)
+        string PCHFile;
+
+        ProcessStartInfo generateStartUpInfo(string extraArgs)
+        {
+            // Returns a ProcessStartInfo object with the following properties
+            return new ProcessStartInfo
+            {
+                // Compiler location
+                FileName = compilerLocation,
+
+                // Arguments
+                Arguments = $"-std=c++17 -I \"{projectDir + "/build"}\" " + extraArgs,
+
+                // Default values
+                UseShellExecute = false,
+                RedirectStandardError = true,
+                RedirectStandardOutput = true,
+                CreateNoWindow = true
+            };
+        }
+
+        // Runs the compiler and returns true (along with the output of the compiler) if it failed
+        bool RunCompiler(string args, string failMessage, out string error)
+        {
+            using (Process p = Process.Start(generateStartUpInfo(args)))
+            {
+                if (p == null)
+                {
+                    error = $"Failed to start {compilerLocation}";
+                    return true;
+                }
+
+                // The output has to be read before waiting otherwise a full pipe would block the compiler
+                string output = p.StandardError.ReadToEnd();
+
+                // Waits for the compiler to finish
+                p.WaitForExit();
+
+                if (p.ExitCode != 0)
+                {
+                    error = failMessage + "\n" + output;
+                    return true;
+                }
+            }
+
+            error = null;
+            return false;
+        }
+
+        // Function to precompile the header that is included by every translated file
+        public bool CompilePrecompiledHeader(string headerFile, string sourceFile, out string error)
+        {
+            // GCC looks for "<header>.gch" next to the header, Clang is given the file directly
+            string pchFile = headerFile + (isClang ? ".pch" : ".gch");
+
+            // Does not recompile the header if it has not changed since the last build
+            if (IncrementalBuild.IsUpToDate(headerFile, pchFile, Path.Combine(projectDir, "build")))
+            {
+                PCHFile = pchFile;
+
+                error = null;
+                return false;
+            }
+
+            if (RunCompiler($"-x c++-header \"{headerFile}\" -o \"{pchFile}\"", "Creating the precompiled header failed.", out error)) return true;
+
+            PCHFile = pchFile;
+            return false;
+        }
+
+        // Function to compile a .cpp file to a .o file
+        public bool CompileToObj(string fileName, out string error)
+        {
+            string objFileName = Path.ChangeExtension(fileName, ".o");
+
+            // Does not recompile files that have not changed since the last build
+            if (IncrementalBuild.IsUpToDate(fileName, objFileName, Path.Combine(projectDir, "build")))
+            {
+                error = null;
+                return false;
+            }
+
+            // Uses the precompiled header if there is one
+            string pchArgs = (isClang && PCHFile != null) ? $" -include-pch \"{PCHFile}\"" : "";
+
+            return RunCompiler($"-c \"{fileName}\" -o \"{objFileName}\"{pchArgs}", $"Compilation of {fileName} failed.", out error);
+        }
+
+        // Function to compile multiple .cpp files to multiple .o files
+        public bool CompileToObjs(string[] fileNames, out string error)
+        {
+            // Loops through all the file names
+            foreach (string fileName in fileNames)
+            {
+                if (CompileToObj(fileName, out error)) return true;
+            }
+
+            error = null;
+            return false;
+        }
+
+        // Function to link multiple .o files to an executable
+        public bool LinkObjsToExe(string mainDir, string exeFileName, out string error)
+        {
+            // Creates the path to the executable
+            DateTime now = DateTime.Now;
+            exeFileName = Path.Combine(mainDir, exeFileName) + "_" + now.ToString("yyyy-MM-dd_HH-mm-ss") + (OperatingSystem.IsWindows() ? ".exe" : "");
+
+            // Gets all the .o files in the build directory
+            string objFiles = string.Join(" ", Directory.GetFiles(Path.Combine(mainDir, "build"), "*.o").Select(file => $"\"{file}\""));
+
+            return RunCompiler($"{objFiles} -o \"{exeFileName}\"", "Linking the object files failed.", out error);
+        }
+
+        public static bool Create(string buildInfoPath, ref JsonElement compilerJSON, bool isClang, out GNU_Compiler res, out string error)
+        {
+            res = new GNU_Compiler();
+
+            res.projectDir = Path.GetDirectoryName(buildInfoPath);
+            res.isClang = isClang;
+
+            // Gets the location of the compiler (defaults to the one on the PATH)
+            try { res.compilerLocation = compilerJSON.GetProperty("path").GetString(); }
+            catch (KeyNotFoundException) { res.compilerLocation = null; }
+
+            if (res.compilerLocation == null)
+            {
+                res.compilerLocation = isClang ? "clang++" : "g++";
+            }
+
+            error = null;
+            return false;
+        }
+
+        // Use Create to make a GNU_Compiler
+        GNU_Compiler()
+        { }
+    }
+}
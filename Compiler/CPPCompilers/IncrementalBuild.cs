@@ -0,0 +1,87 @@
+﻿// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+// ======================================================================================= //
+
+// Standard Libraries
+using System;
+using System.Collections.Generic;
+using System.IO;
+
+// Project namespace
+namespace LX
+{
+    // Used by the compilers to skip files that have not changed since the last build
+    // The translator only rewrites files whose contents changed so their modification times can be trusted
+    public static class IncrementalBuild
+    {
+        // Returns true if the output file is newer than the source file and every header it includes from the include directory
+        public static bool IsUpToDate(string sourceFile, string outputFile, string includeDir)
+        {
+            if (File.Exists(outputFile) == false) return false;
+
+            DateTime outputTime = File.GetLastWriteTimeUtc(outputFile);
+
+            return IsOlderThan(sourceFile, outputTime, includeDir, new HashSet<string>());
+        }
+
+        static bool IsOlderThan(string file, DateTime time, string includeDir, HashSet<string> visited)
+        {
+            // Headers that are included multiple times only need to be checked once
+            if (visited.Add(Path.GetFullPath(file)) == false) return true;
+
+            if (File.Exists(file) == false) return false;
+            if (File.GetLastWriteTimeUtc(file) > time) return false;
+
+            foreach (string line in File.ReadLines(file))
+            {
+                string trimmed = line.Trim();
+                if (trimmed.StartsWith("#include") == false) continue;
+
+                // Gets the name of the header between the <> or ""
+                int start = trimmed.IndexOfAny(new char[] { '<', '"' });
+                int end = trimmed.LastIndexOfAny(new char[] { '>', '"' });
+                if (start == -1 || end <= start) continue;
+
+                // Only headers created by the translator are checked as the standard headers do not change between builds
+                string header = Path.Combine(includeDir, trimmed.Substring(start + 1, end - start - 1));
+                if (File.Exists(header) && IsOlderThan(header, time, includeDir, visited) == false) return false;
+            }
+
+            return true;
+        }
+    }
+}
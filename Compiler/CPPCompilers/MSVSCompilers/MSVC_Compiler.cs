@@ -70,6 +70,11 @@ namespace LX
         protected string UCRTLibPath;
         protected string UMLibPath;
 
+        // Name of the precompiled header and the .pch file made from it
+        // Both are null until CompilePrecompiledHeader has been called
+        protected string PCHHeaderName;
+        protected string PCHFile;
+
         protected ProcessStartInfo generateStartUpInfo(string extraArgs)
         {
             // Adds spaces to the beginning and end of the extra arguments
@@ -85,6 +90,7 @@ namespace LX
                 // Arguments
                 Arguments =
                 $"/I \"{MSVCIncludePath}\" /I \"{UCRTIncludePath}\" /I \"{sharedIncludePath}\" /I \"{UMIncludePath}\" /I \"{projectDir + "/build"}\"" // Include paths
+                + " /std:c++17"                                                                                                                       // The runtime library needs C++17
                 + extraArgs                                                                                                                           // Passed in arguments
                 + $" /LIBPATH:\"{MSVCLibPath}\" /LIBPATH:\"{UCRTLibPath}\" /LIBPATH:\"{UMLibPath}\"",                                                 // Library paths
 
@@ -96,6 +102,9 @@ namespace LX
             };
         }
 
+        // Function to precompile the header that is included by every translated file
+        public abstract bool CompilePrecompiledHeader(string headerFile, string sourceFile, out string error);
+
         // Function to compile a .cpp file to a .obj file
         public abstract bool CompileToObj(string fileName, out string error);
 
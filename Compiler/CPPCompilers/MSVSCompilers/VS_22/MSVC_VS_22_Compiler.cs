@@ -48,6 +48,51 @@ namespace LX
 {
     public partial class MSVC_VS_22_Compiler : MSVC_Compiler
     {
+        // Function to precompile the header that is included by every translated file
+        // MSVC creates the .pch whilst compiling a .cpp file that includes the header (/Yc)
+        public override bool CompilePrecompiledHeader(string headerFile, string sourceFile, out string error)
+        {
+            // The .obj file also has to be linked into the .exe
+            string objFileName = sourceFile.Replace(".cpp", ".obj");
+            string pchFile = Path.ChangeExtension(headerFile, ".pch");
+            string headerName = Path.GetFileName(headerFile);
+
+            // Does not recompile the header if it has not changed since the last build
+            if (IncrementalBuild.IsUpToDate(sourceFile, pchFile, projectDir + "\\build") && File.Exists(objFileName))
+            {
+                PCHHeaderName = headerName;
+                PCHFile = pchFile;
+
+                error = null;
+                return false;
+            }
+
+            // Compiles the header
+            using (Process p = Process.Start(generateStartUpInfo($"/EHsc /c \"{sourceFile}\" /Yc\"{headerName}\" /Fp\"{pchFile}\" /Fo\"{objFileName}\" /link")))
+            {
+                if (p == null)
+                {
+                    error = "Failed to start process to create the precompiled header using MSVC";
+                    return true;
+                }
+
+                // Waits for the Compilation to finish
+                p.WaitForExit();
+
+                if (p.ExitCode != 0)
+                {
+                    error = "Creating the precompiled header, using MSVC, failed.";
+                    return true;
+                }
+            }
+
+            // All files compiled from now on will use the precompiled header
+            PCHHeaderName = headerName;
+            PCHFile = pchFile;
+
+            error = null;
+            return false;
+        }
 
         // Function to compile a .cpp file to a .obj file
         public override bool CompileToObj(string fileName, out string error)
@@ -55,8 +100,18 @@ namespace LX
             // Replace .cpp with .obj for the output file
             string objFileName = fileName.Replace(".cpp", ".obj");
 
+            // Does not recompile files that have not changed since the last build
+            if (IncrementalBuild.IsUpToDate(fileName, objFileName, projectDir + "\\build"))
+            {
+                error = null;
+                return false;
+            }
+
+            // Uses the precompiled header if there is one (/Yu)
+            string pchArgs = (PCHFile == null) ? "" : $" /Yu\"{PCHHeaderName}\" /Fp\"{PCHFile}\"";
+
             // Compiles the file
-            using (Process p = Process.Start(generateStartUpInfo($"/EHsc /c \"{fileName}\" /Fo\"{objFileName}\" /link")))
+            using (Process p = Process.Start(generateStartUpInfo($"/EHsc /c \"{fileName}\" /Fo\"{objFileName}\"{pchArgs} /link")))
             {
                 if (p == null)
                 {
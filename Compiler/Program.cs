@@ -63,12 +63,40 @@ namespace LX
 
         // 
         [DllImport("API.dll", CallingConvention = CallingConvention.Cdecl)]
-        private static extern bool translateAST(string folder, string filename, bool debug, int id);
+        private static extern bool translateAST(string filename, int id);
+
+        //
+        [DllImport("API.dll", CallingConvention = CallingConvention.Cdecl)]
+        private static extern void setUnityBuild(uint units, uint maxFunctions, uint maxBytes);
+
+        //
+        [DllImport("API.dll", CallingConvention = CallingConvention.Cdecl)]
+        private static extern bool writeOutputFiles(string folder);
 
         //
         [DllImport("API.dll", CallingConvention = CallingConvention.Cdecl)]
         private static extern bool CreateHeaderFile(string folder);
 
+        //
+        [DllImport("API.dll", CallingConvention = CallingConvention.Cdecl)]
+        private static extern bool prefetchSources(string folder, string srcDir, string[] fileNames, int count);
+
+        //
+        [DllImport("API.dll", CallingConvention = CallingConvention.Cdecl)]
+        private static extern bool configureOptimizer(string name, bool enabled);
+
+        //
+        [DllImport("API.dll", CallingConvention = CallingConvention.Cdecl)]
+        private static extern bool setOptimizationProfile(string profile);
+
+        //
+        [DllImport("API.dll", CallingConvention = CallingConvention.Cdecl)]
+        private static extern bool configureOptimizerLimit(string name, uint value);
+
+        //
+        [DllImport("API.dll", CallingConvention = CallingConvention.Cdecl)]
+        private static extern bool optimizeProject(string folder, bool debug);
+
         // Main function
         static void Main(string[] args)
         {
@@ -121,12 +149,79 @@ namespace LX
                 try { debug = info.JsonDoc.RootElement.GetProperty("debug").GetBoolean(); }
                 catch (KeyNotFoundException) { /* Should be empty */ }
 
+                // Gets the unity build settings (without them every function gets its own .cpp file)
+                try
+                {
+                    JsonElement unityJSON = info.JsonDoc.RootElement.GetProperty("unity");
+
+                    uint units = 0, maxFunctions = 0, maxBytes = 0;
+                    try { units = unityJSON.GetProperty("units").GetUInt32(); } catch (KeyNotFoundException) { }
+                    try { maxFunctions = unityJSON.GetProperty("max-functions").GetUInt32(); } catch (KeyNotFoundException) { }
+                    try { maxBytes = unityJSON.GetProperty("max-bytes").GetUInt32(); } catch (KeyNotFoundException) { }
+
+                    setUnityBuild(units, maxFunctions, maxBytes);
+                }
+                catch (KeyNotFoundException) { /* Should be empty */ }
+
+                // Gets the optimization settings
+                // The profile is applied first so single optimizations can be turned on or off on top of it
+                try
+                {
+                    JsonElement optimizationsJSON = info.JsonDoc.RootElement.GetProperty("optimizations");
+
+                    try
+                    {
+                        string profile = optimizationsJSON.GetProperty("profile").GetString() ?? "";
+
+                        if (setOptimizationProfile(profile) == false)
+                        {
+                            throw new Exception("Unknown optimization profile: " + profile);
+                        }
+                    }
+                    catch (KeyNotFoundException) { }
+
+                    foreach (JsonProperty option in optimizationsJSON.EnumerateObject())
+                    {
+                        if (option.Name == "profile")
+                        {
+                            continue;
+                        }
+
+                        // Numbers are limits of the optimizations (such as "inline-threshold") instead of turning one on or off
+                        if (option.Value.ValueKind == JsonValueKind.Number)
+                        {
+                            if (configureOptimizerLimit(option.Name, option.Value.GetUInt32()) == false)
+                            {
+                                throw new Exception("Unknown optimization limit: " + option.Name);
+                            }
+                        }
+
+                        else if (configureOptimizer(option.Name, option.Value.GetBoolean()) == false)
+                        {
+                            throw new Exception("Unknown optimization: " + option.Name);
+                        }
+                    }
+                }
+                catch (KeyNotFoundException) { /* Should be empty */ }
+
+                // Every parsed file and the ID the API gave it
+                // All the files are parsed before any are translated so the optimizer can see the whole project
+                List<(string fileName, int ID)> parsedFiles = new List<(string fileName, int ID)>();
+
                 // Loops through all the source directories
                 foreach (string srcDir in info.SourceDirs)
                 {
                     // Finds all the .lx files in the source directory
                     string[] files = Directory.GetFiles(srcDir, "*.lx");
 
+                    // Reads all of the files at once instead of one at a time whilst lexing
+                    string[] fileNames = files.Select(file => Path.GetFileNameWithoutExtension(file) + ".lx").ToArray();
+
+                    if (prefetchSources(info.ProjectDir, Path.GetFileNameWithoutExtension(srcDir), fileNames, fileNames.Length) == false)
+                    {
+                        throw new Exception("An error occured whilst reading the source files");
+                    }
+
                     // Loops through all the .lx files
                     foreach (string file in files)
                     {
@@ -141,30 +236,66 @@ namespace LX
                         {
                             throw new Exception("An error occured during parsing");
                         }
+
+                        parsedFiles.Add((Path.GetFileNameWithoutExtension(file) + ".lx", ID));
                     }
+                }
 
-                    int nextID = 0;
+                // Optimizes the AST of every file
+                if (optimizeProject(info.ProjectDir, debug) == false)
+                {
+                    throw new Exception("An error occured during optimization");
+                }
 
-                    foreach (string file in files)
+                foreach ((string fileName, int ID) in parsedFiles)
+                {
+                    if (translateAST(fileName, ID) == false)
                     {
-                        if (translateAST(info.ProjectDir, Path.GetFileNameWithoutExtension(file) + ".lx", debug, nextID) == false)
-                        {
-                            throw new Exception("An error occured during translation");
-                        }
-
-                        nextID++;
+                        throw new Exception("An error occured during translation");
                     }
                 }
 
+                // Writes the translated functions to .cpp files
+                if (writeOutputFiles(info.ProjectDir) == false)
+                {
+                    throw new Exception("An error occured whilst writing the translated files");
+                }
+
                 // Creates a header file
                 if (CreateHeaderFile(info.ProjectDir) == false)
                 {
                     throw new Exception("An error occured during header file creation");
                 }
 
+                // Precompiles the header that is included by every translated file
+                string buildDir = Path.Combine(info.ProjectDir, "build");
+
+                // Copies the runtime library used by the translated code to the build folder
+                // It is only copied when it has changed so the files that include it are not recompiled every build
+                string runtimeHeader = Path.Combine(AppContext.BaseDirectory, "lx-runtime.h");
+                string runtimeHeaderCopy = Path.Combine(buildDir, "lx-runtime.h");
+
+                if (File.Exists(runtimeHeaderCopy) == false || File.ReadAllBytes(runtimeHeaderCopy).SequenceEqual(File.ReadAllBytes(runtimeHeader)) == false)
+                {
+                    File.Copy(runtimeHeader, runtimeHeaderCopy, true);
+                }
+
+                if (c.CompilePrecompiledHeader(Path.Combine(buildDir, "lx-prelude.h"), Path.Combine(buildDir, "lx-prelude.cpp"), out error))
+                {
+                    Console.WriteLine($"An error occured whilst precompiling the prelude header: ");
+                    Console.WriteLine(error);
+                    return;
+                }
+
                 // Loop through all the .cpp files in the project directory
-                foreach (string file in Directory.GetFiles(Path.Combine(info.ProjectDir, "build"), "*.cpp"))
+                foreach (string file in Directory.GetFiles(buildDir, "*.cpp"))
                 {
+                    // The prelude source was already compiled with the precompiled header
+                    if (Path.GetFileName(file) == "lx-prelude.cpp")
+                    {
+                        continue;
+                    }
+
                     // Compiles the .cpp file to a .obj file
                     if (c.CompileToObj(file, out error))
                     {
@@ -47,6 +47,9 @@ namespace LX::Lexer
 	// Constepr functions to check if a character is a letter or number
 	static bool constexpr isAlphaNumeric(const char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'); }
 
+	// Constepr function to check if a character is a digit
+	static bool constexpr isDigit(const char c) { return c >= '0' && c <= '9'; }
+
 	// Constepr function to check if a character is whitespace
 	static bool constexpr isWhitespace(const char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
 
@@ -61,7 +64,19 @@ namespace LX::Lexer
 		{ "int", TokenType::INT_DEC },
 		{ "string", TokenType::STR_DEC },
 
+		{ "i8", TokenType::I8_DEC },
+		{ "i16", TokenType::I16_DEC },
+		{ "i32", TokenType::I32_DEC },
+		{ "i64", TokenType::I64_DEC },
+		{ "u8", TokenType::U8_DEC },
+		{ "u16", TokenType::U16_DEC },
+		{ "u32", TokenType::U32_DEC },
+		{ "u64", TokenType::U64_DEC },
+		{ "f32", TokenType::F32_DEC },
+		{ "f64", TokenType::F64_DEC },
+
 		{ "const", TokenType::CONST },
+		{ "static", TokenType::STATIC },
 
 		// Control flow
 		{ "if", TokenType::IF },
@@ -108,6 +123,12 @@ namespace LX::Lexer
 				// Loops until it reaches a non-alphanumeric character
 				while (currentIndex < currentLength && isAlphaNumeric((*current)[currentIndex++]));
 
+				// Numbers can have a decimal point (such as 1.5) if it is followed by a digit
+				if (isDigit((*current)[wordStart]) && (*current)[currentIndex - 1] == '.' && currentIndex < currentLength && isDigit((*current)[currentIndex]))
+				{
+					while (currentIndex < currentLength && isAlphaNumeric((*current)[currentIndex++]));
+				}
+
 				// Decrements (for some reason)
 				currentIndex--;
 
@@ -252,6 +273,16 @@ namespace LX::Lexer
 						MULTI_CASE_OP(LESS_THAN)
 					}
 
+					case '&':
+					{
+						static std::unordered_map<char, TokenType> opMap
+						{
+							{ '&', TokenType::AND }
+						};
+
+						MULTI_CASE_OP(REFERENCE)
+					}
+
 					case ':':
 					{
 						static std::unordered_map<char, TokenType> opMap
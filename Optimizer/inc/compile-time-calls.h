@@ -0,0 +1,136 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+#include <expression.h>
+#include <optimizer.h>
+
+namespace LX::Optimizer
+{
+	/*
+	* @brief Runs functions of the project on constant arguments while compiling
+	* Only calls that give exactly the same result as the C++ code would at runtime are evaluated
+	* A call is given up as soon as it does something that cannot be done at compile time (such as calling print or flush)
+	* The AST is never changed so functions can be read while they are being evaluated
+	*/
+	class CompileTimeEvaluator
+	{
+		private:
+			// A variable of a function being evaluated
+			struct Variable
+			{
+				bool isString = false;
+
+				// NONE until the variable has been given a value
+				Constant value;
+			};
+
+			// Variables of a function call (one map per scope)
+			struct Frame
+			{
+				std::vector<std::unordered_map<std::string, Variable>> scopes;
+
+				Constant returnValue;
+			};
+
+			// What a statement did
+			enum class Flow : char
+			{
+				NEXT,
+				RETURN,
+				BREAK,
+				CONTINUE,
+				FAIL
+			};
+
+			// Functions of the project by name (overloaded functions are left out as the call could be to either of them)
+			std::unordered_map<std::string, const LX::Parser::FunctionDeclaration*> functions;
+
+			// Number of statements and expressions that can still be run before the evaluation is given up
+			size_t stepsLeft = 0;
+
+			// Number of calls being evaluated (stops deep recursion from overflowing the stack)
+			size_t depth = 0;
+
+			bool step();
+
+			Constant call(const LX::Parser::FunctionDeclaration& func, const std::vector<Constant>& args);
+
+			Flow runBlock(const LX::Parser::AST& body, Frame& frame);
+			Flow runStatement(const LX::Parser::ASTNode* node, Frame& frame);
+			Flow runLoop(const LX::Parser::LoopStatement* loop, Frame& frame);
+
+			Constant evaluateExpression(const LX::Parser::ASTNode* node, Frame& frame);
+			Constant evaluateTree(const ExpressionView& tree, Frame& frame);
+
+			// Returns nullptr if the expression is not a variable of the function
+			Variable* findVariable(const ExpressionView& tree, Frame& frame);
+			Variable* findVariable(const std::string& name, Frame& frame);
+
+			// Converts the value to the type of the variable (returns false if C++ would not do the same)
+			static bool store(Variable& var, const Constant& value);
+
+		public:
+			// Most statements and expressions a single call can run
+			static constexpr size_t STEP_LIMIT = 100000;
+
+			// Deepest chain of calls that is evaluated
+			static constexpr size_t DEPTH_LIMIT = 256;
+
+			CompileTimeEvaluator(const std::vector<LX::Parser::FunctionDeclaration*>& project);
+
+			/*
+			* @brief Evaluates a call with only literal arguments
+			*
+			* @return The result or a NONE constant if the call cannot be evaluated (error is set if this was because of an error in the code)
+			*/
+			Constant evaluate(const LX::Parser::FunctionCall* call);
+
+			std::string error;
+	};
+
+	/*
+	* @brief Replaces the calls of a function that only have literal arguments with their results
+	* Strings are only replaced where a string literal means the same as a std::string (such as the value of a variable)
+	*
+	* @return The names of the functions whose calls were replaced (once for each call)
+	*/
+	std::vector<std::string> replaceCompileTimeCalls(LX::Parser::FunctionDeclaration& func, CompileTimeEvaluator& evaluator, Diagnostics& out);
+}
@@ -0,0 +1,86 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+#include <expression.h>
+#include <optimizer.h>
+
+namespace LX::Optimizer
+{
+	/*
+	* @brief Folds the constant expressions of a function and replaces const int variables with their values
+	* Only operations that give exactly the same result as the C++ code would at runtime are folded
+	* Anything else (such as an overflow) is left for the C++ compiler and a warning is given
+	*/
+	class ConstantFolder
+	{
+		private:
+			// Known values of the variables in each scope (NONE for variables that are not constant)
+			// Variables that are not constant are still stored so they hide ones with the same name in outer scopes
+			std::vector<std::unordered_map<std::string, Constant>> scopes;
+
+			// Function being folded (for warnings)
+			const std::string* functionName = nullptr;
+
+			Diagnostics* diagnostics = nullptr;
+
+			void declare(const std::string& name, const Constant& value);
+			Constant lookup(const std::string& name) const;
+
+			void foldBlock(LX::Parser::AST& body);
+			void foldStatement(std::unique_ptr<LX::Parser::ASTNode>& node);
+
+			// Folds an expression and returns its value if it is now a literal
+			// Variables in lvalue positions (such as the x in x += 1) are never replaced
+			Constant foldExpression(std::unique_ptr<LX::Parser::ASTNode>& node, bool isLValue = false);
+			Constant foldTree(Expression& tree, bool isLValue);
+
+			void warn(const std::string& message);
+
+		public:
+			// Number of operations replaced with their result
+			size_t folded = 0;
+
+			// Number of variables replaced with their value
+			size_t propagated = 0;
+
+			void fold(LX::Parser::FunctionDeclaration& func, Diagnostics& out);
+	};
+}
@@ -0,0 +1,98 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+#include <optimizer.h>
+
+namespace LX::Optimizer
+{
+	/*
+	* @brief Removes stores to variables that are never read afterwards and variables that are never used
+	* If the value of a store has side effects (such as calling a function) only the value is kept as an expression statement
+	* So the side effects still happen in the same order without the variable being kept
+	*/
+	class DeadStoreEliminator
+	{
+		private:
+			// Variables that are read before they are next written to
+			typedef std::unordered_set<std::string> LiveSet;
+
+			// Number of times each variable name is read or written to in the function
+			std::unordered_map<std::string, size_t> references;
+
+			// Variables that can be read outside of the function, on the next call (static) or through another name (references)
+			// Stores to these are never dead
+			LiveSet aliased;
+
+			// Variables that are live anywhere in each loop around the current statement (innermost last)
+			// A break or continue can go to the end or the start of the loop so everything live there is live at the jump
+			std::vector<LiveSet> loopLive;
+
+			// Set when anything is removed so the function is checked again
+			bool changed = false;
+
+			void countReferences(LX::Parser::FunctionDeclaration& func);
+
+			void findAliased(LX::Parser::FunctionDeclaration& func);
+
+			// Returns true if a store to the variable would never be read
+			bool isDead(const LiveSet& live, const std::string& name) const;
+
+			/*
+			* @brief Removes the dead stores of a block working backwards from the end
+			*
+			* @param live Variables that are live at the end of the block
+			* @param liveAfterBlock Variables of the enclosing scope that are live after the block
+			*        A variable declared in the block hides the one of the enclosing scope so this is used to restore its liveness
+			*
+			* @return The variables that are live at the start of the block
+			*/
+			LiveSet eliminateInBlock(LX::Parser::AST& body, LiveSet live, const LiveSet& liveAfterBlock);
+
+		public:
+			// Number of assignments (and increments) that were removed
+			size_t removedStores = 0;
+
+			// Names of the variables whose declarations were removed
+			std::vector<std::string> removedVariables;
+
+			void eliminate(LX::Parser::FunctionDeclaration& func);
+	};
+}
@@ -0,0 +1,156 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+namespace LX::Optimizer
+{
+	// A value that is known at compile time
+	struct Constant
+	{
+		enum class Type : char
+		{
+			NONE, // Not known at compile time
+			INT,
+			BOOL,
+			STRING
+		};
+
+		Type type = Type::NONE;
+
+		// Value of an INT or BOOL (0 or 1)
+		long long intValue = 0;
+
+		// Value of a STRING as it is written in the source (escape sequences are not processed)
+		std::string stringValue;
+
+		inline bool isKnown() const { return type != Type::NONE; }
+
+		static Constant fromInt(long long value);
+		static Constant fromBool(bool value);
+		static Constant fromString(const std::string& value);
+	};
+
+	// Returns the value of a literal (integers, true/false and strings) or a NONE constant for anything else
+	Constant literalValue(const LX::Parser::ASTNode* node);
+
+	// Creates the node that is translated to the constant
+	std::unique_ptr<LX::Parser::ASTNode> makeLiteral(const Constant& value);
+
+	/*
+	* @brief Applies a binary operator to two constants the same way the C++ code would at runtime
+	* LX int is a C++ int so integers are 32 bit and overflow (or dividing by zero) is an error
+	*
+	* @return The result or a NONE constant if it cannot be calculated (error is set if this was because of an error in the code)
+	*/
+	Constant evaluateBinary(LX::Lexer::TokenType op, const Constant& lhs, const Constant& rhs, std::string& error);
+
+	// Same as above for prefix operators (such as -x and !x)
+	Constant evaluatePrefix(LX::Lexer::TokenType op, const Constant& value, std::string& error);
+
+	// Returns true if the operator assigns to its left hand side (such as +=)
+	bool isAssignmentOperator(LX::Lexer::TokenType op);
+
+	/*
+	* @brief Tree of an expression using the C++ operator precedence
+	* The parser builds chains of operations from right to left without any precedence and the translator writes them out flat
+	* This means the meaning of an expression is decided by the C++ compiler so the optimizer has to read them the same way
+	* Anything that is not an operation (identifiers, literals, function calls, brackets) is a leaf
+	*/
+	struct Expression
+	{
+		enum class Kind : char
+		{
+			LEAF,
+			BINARY,
+			PREFIX,
+			POSTFIX
+		};
+
+		Kind kind = Kind::LEAF;
+
+		// Node of a leaf
+		std::unique_ptr<LX::Parser::ASTNode> leaf;
+
+		// Operator of a BINARY, PREFIX or POSTFIX
+		LX::Lexer::TokenType op = LX::Lexer::TokenType::UNDEFINED;
+
+		// Operands (PREFIX and POSTFIX only use lhs)
+		std::unique_ptr<Expression> lhs;
+		std::unique_ptr<Expression> rhs;
+
+		// Turns the expression into a leaf holding the node
+		void makeLeaf(std::unique_ptr<LX::Parser::ASTNode> node);
+	};
+
+	/*
+	* @brief Moves the nodes of an expression into a tree
+	* Returns nullptr (without changing the node) if the expression is incomplete because of an earlier parser error
+	* The node is empty until the tree is turned back into an AST with fromTree
+	*/
+	std::unique_ptr<Expression> toTree(std::unique_ptr<LX::Parser::ASTNode>& node);
+
+	// Turns the tree back into nodes that are translated to the same expression (brackets are added where needed)
+	std::unique_ptr<LX::Parser::ASTNode> fromTree(std::unique_ptr<Expression> tree);
+
+	/*
+	* @brief Same as Expression but the leaves point to the nodes of the AST instead of owning them
+	* Used to read an expression in the C++ order without changing the AST
+	*/
+	struct ExpressionView
+	{
+		Expression::Kind kind = Expression::Kind::LEAF;
+
+		// Node of a leaf
+		const LX::Parser::ASTNode* leaf = nullptr;
+
+		// Operator of a BINARY, PREFIX or POSTFIX
+		LX::Lexer::TokenType op = LX::Lexer::TokenType::UNDEFINED;
+
+		// Operands (PREFIX and POSTFIX only use lhs)
+		std::unique_ptr<ExpressionView> lhs;
+		std::unique_ptr<ExpressionView> rhs;
+
+		// Turns the expression into a leaf pointing to the node
+		void makeLeaf(const LX::Parser::ASTNode* node);
+	};
+
+	// Builds the tree of an expression without changing it (returns nullptr if the expression is incomplete)
+	std::unique_ptr<ExpressionView> viewTree(const LX::Parser::ASTNode* node);
+}
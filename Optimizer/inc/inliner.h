@@ -0,0 +1,99 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+#include <optimizer.h>
+
+namespace LX::Optimizer
+{
+	/*
+	* @brief Replaces calls to small functions with the expression they return
+	* Every function is translated to its own .cpp file so the C++ compiler cannot inline them itself (without link time optimization)
+	* Only functions whose body is a single return statement are inlined as a call can be part of any expression
+	* A call is only inlined if it means exactly the same afterwards (arguments are never run more than once or in a different order)
+	*/
+	class Inliner
+	{
+		private:
+			// A function that calls could be inlined to
+			struct Callee
+			{
+				const LX::Parser::FunctionDeclaration* func = nullptr;
+
+				// Why the calls of the function are never inlined (empty if they can be)
+				std::string reason;
+			};
+
+			std::unordered_map<std::string, Callee> callees;
+
+			// Types of the variables of the function being inlined into (empty for names that are declared with different types)
+			std::unordered_map<std::string, std::string> variableTypes;
+
+			// Function being inlined into
+			const std::string* functionName = nullptr;
+
+			std::vector<std::string>* report = nullptr;
+
+			// Names of the functions whose calls were inlined
+			std::vector<std::string> inlined;
+
+			void inlineBlock(LX::Parser::AST& body);
+			void inlineStatement(std::unique_ptr<LX::Parser::ASTNode>& node);
+			void inlineExpression(std::unique_ptr<LX::Parser::ASTNode>& node);
+
+			// Returns why the call cannot be inlined (empty if it can be)
+			std::string checkCall(const LX::Parser::FunctionCall* call, const Callee& callee) const;
+			std::string checkArgument(const LX::Parser::ASTNode* arg, const std::string& paramType) const;
+
+		public:
+			// Largest number of nodes the returned expression of an inlined function can have
+			size_t threshold;
+
+			Inliner(const std::vector<LX::Parser::FileAST*>& files, size_t threshold);
+
+			/*
+			* @brief Inlines the calls of a function (calls that were added by inlining are inlined as well)
+			* The decision made for each call to a function of the project is added to the report
+			*
+			* @return The names of the functions whose calls were inlined (once for each call)
+			*/
+			std::vector<std::string> inlineCalls(LX::Parser::FunctionDeclaration& func, std::vector<std::string>& out);
+	};
+}
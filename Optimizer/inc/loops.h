@@ -0,0 +1,67 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+#include <optimizer.h>
+
+namespace LX::Optimizer
+{
+	/*
+	* @brief Replaces for loops that count an int between two literals with a copy of the body for each value of the counter
+	* The counter is replaced with its value in each copy so the copies can be folded further
+	* Loops are only unrolled if their body does not change the counter, break, continue or declare a variable of its own
+	*
+	* @param limit Most times the body of a loop can be run for it to be unrolled
+	* @param referenceFunctions The result of functionsWithReferenceParameters (passing the counter to these could change it)
+	*
+	* @return The number of loops that were unrolled
+	*/
+	size_t unrollLoops(LX::Parser::FunctionDeclaration& func, size_t limit, const std::unordered_set<std::string>& referenceFunctions);
+
+	/*
+	* @brief Moves int expressions that have the same value on every run of a loop into const variables before the loop
+	* Only expressions without calls or side effects (and that cannot divide by zero) are moved as they are now always calculated
+	*
+	* @param referenceFunctions The result of functionsWithReferenceParameters (arguments passed to these can change)
+	*
+	* @return The number of expressions that were moved
+	*/
+	size_t hoistLoopInvariants(LX::Parser::FunctionDeclaration& func, const std::unordered_set<std::string>& referenceFunctions);
+}
@@ -0,0 +1,117 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+namespace LX::Optimizer
+{
+	// Which optimizations are run on the AST before it is translated
+	struct Options
+	{
+		// Evaluates operations on literals and replaces const int variables with their values
+		bool constantFolding = true;
+
+		// Replaces calls to small functions with the expression they return
+		bool inlining = true;
+
+		// Largest number of nodes the returned expression of a function can have for it to be inlined
+		size_t inlineThreshold = 12;
+
+		// Replaces calls to functions of the project that only have literal arguments with their results
+		bool compileTimeCalls = true;
+
+		// Removes functions that cannot be called from main
+		bool deadFunctions = true;
+
+		// Removes stores to variables that are never read and variables that are never used
+		bool deadStores = true;
+
+		// Creates const variables with a literal value once for the whole program (as static variables)
+		bool staticConstants = true;
+
+		// Passes string parameters that are never written to by const reference instead of copying them
+		bool referenceParams = true;
+
+		// Replaces for loops that run a small constant number of times with a copy of the body for each run
+		bool loopUnrolling = true;
+
+		// Most times the body of a loop can be run for it to be unrolled
+		size_t unrollLimit = 8;
+
+		// Calculates int expressions that are the same on every run of a loop once before the loop
+		bool loopInvariants = true;
+
+		// Prints what each optimization changed
+		bool report = false;
+
+		// Sets an option by the name used in the .lx-build file (returns false if there is no option with that name)
+		bool set(const std::string& name, bool enabled);
+
+		// Sets a limit by the name used in the .lx-build file (returns false if there is no limit with that name)
+		bool setLimit(const std::string& name, size_t value);
+
+		// Sets every optimization to the default of a profile ("debug" or "release")
+		// Returns false if the profile does not exist
+		bool setProfile(const std::string& profile);
+	};
+
+	// Messages from optimizing a function
+	// Functions are optimized in parallel so they are stored and printed in order afterwards
+	struct Diagnostics
+	{
+		// Always printed
+		std::vector<std::string> warnings;
+
+		// Only printed when the report option is set
+		std::vector<std::string> notes;
+	};
+
+	// Decisions that are written to a file instead of being printed as there is one for every call
+	struct Report
+	{
+		// Why each call to a function of the project was or was not inlined
+		std::vector<std::string> inlining;
+	};
+
+	/*
+	* @brief Runs the enabled optimizations on every function of the files
+	* Files should be given in the same order every time so the report is always the same
+	*/
+	Report optimize(const std::vector<LX::Parser::FileAST*>& files, const Options& options);
+}
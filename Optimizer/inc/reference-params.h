@@ -0,0 +1,65 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+#include <optimizer.h>
+
+namespace LX::Optimizer
+{
+	// Names of the functions with a parameter that is a (non const) reference
+	// Arguments passed to these functions may be written to by the call
+	std::unordered_set<std::string> functionsWithReferenceParameters(const std::vector<LX::Parser::FileAST*>& files);
+
+	/*
+	* @brief Adds the name of the variable the node could write to (or create a reference to)
+	* Only looks at the node itself so is called for each node of a walk
+	*/
+	void addWrittenVariable(LX::Parser::ASTNode* node, const std::unordered_set<std::string>& referenceFunctions, std::unordered_set<std::string>& written);
+
+	/*
+	* @brief Passes the string parameters that are never written to by const reference instead of by value
+	* This stops a copy of the argument being made for every call of the function
+	*
+	* @param referenceFunctions The result of functionsWithReferenceParameters (from before any parameters were changed)
+	*
+	* @return The names of the parameters that were changed
+	*/
+	std::vector<std::string> passParametersByReference(LX::Parser::FunctionDeclaration& func, const std::unordered_set<std::string>& referenceFunctions);
+}
@@ -0,0 +1,148 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <ast-walk.h>
+
+#include <common.h>
+
+namespace LX::Optimizer
+{
+	void walk(LX::Parser::ASTNode* node, const std::function<void(LX::Parser::ASTNode*)>& func)
+	{
+		using namespace LX::Parser;
+
+		// Nodes can be null after a parser error
+		if (node == nullptr) { return; }
+
+		func(node);
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+				walk(static_cast<VariableDeclaration*>(node)->val.get(), func);
+				return;
+
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+				for (std::unique_ptr<VariableDeclaration>& var : static_cast<DestructuringDeclaration*>(node)->vars)
+				{
+					walk(var.get(), func);
+				}
+
+				walk(static_cast<DestructuringDeclaration*>(node)->val.get(), func);
+				return;
+
+			case ASTNode::NodeType::ASSIGNMENT:
+				walk(static_cast<Assignment*>(node)->val.get(), func);
+				return;
+
+			case ASTNode::NodeType::OPERATION:
+				walk(static_cast<Operation*>(node)->lhs.get(), func);
+				walk(static_cast<Operation*>(node)->rhs.get(), func);
+				return;
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+				walk(static_cast<UnaryOperation*>(node)->val.get(), func);
+				return;
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+				for (std::unique_ptr<ASTNode>& arg : static_cast<FunctionCall*>(node)->args)
+				{
+					walk(arg.get(), func);
+				}
+
+				return;
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				walk(static_cast<BracketedExpression*>(node)->expr.get(), func);
+				return;
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+				for (std::unique_ptr<ASTNode>& value : static_cast<TupleExpression*>(node)->values)
+				{
+					walk(value.get(), func);
+				}
+
+				return;
+
+			case ASTNode::NodeType::IF_STATEMENT:
+			{
+				IfStatement* ifStatement = static_cast<IfStatement*>(node);
+
+				walk(ifStatement->condition.get(), func);
+
+				for (std::unique_ptr<ASTNode>& statement : ifStatement->body)
+				{
+					walk(statement.get(), func);
+				}
+
+				walk(ifStatement->next.get(), func);
+				return;
+			}
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(node);
+
+				walk(loopStatement->init.get(), func);
+				walk(loopStatement->condition.get(), func);
+
+				for (std::unique_ptr<ASTNode>& statement : loopStatement->body)
+				{
+					walk(statement.get(), func);
+				}
+
+				walk(loopStatement->step.get(), func);
+				return;
+			}
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+				walk(static_cast<ReturnStatement*>(node)->expr.get(), func);
+				return;
+
+			default:
+				return;
+		}
+	}
+
+	void walk(LX::Parser::FunctionDeclaration& func, const std::function<void(LX::Parser::ASTNode*)>& callback)
+	{
+		for (std::unique_ptr<LX::Parser::ASTNode>& statement : func.body)
+		{
+			walk(statement.get(), callback);
+		}
+	}
+}
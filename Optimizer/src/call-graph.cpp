@@ -0,0 +1,124 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <call-graph.h>
+
+#include <common.h>
+
+#include <ast-walk.h>
+
+namespace LX::Optimizer
+{
+	void CallGraph::build(const std::vector<LX::Parser::FileAST*>& files)
+	{
+		std::vector<LX::Parser::FunctionDeclaration*> functions;
+
+		for (LX::Parser::FileAST* file : files)
+		{
+			for (LX::Parser::FunctionDeclaration& func : file->functions)
+			{
+				functions.push_back(&func);
+			}
+		}
+
+		// The calls of each function are found in parallel then merged in order
+		std::vector<std::set<std::string>> callees(functions.size());
+
+		LX::Thread::parallelFor(functions.size(), [&](size_t i)
+		{
+			walk(*functions[i], [&](LX::Parser::ASTNode* node)
+			{
+				if (node->type == LX::Parser::ASTNode::NodeType::FUNCTION_CALL)
+				{
+					callees[i].insert(static_cast<LX::Parser::FunctionCall*>(node)->funcName.name);
+				}
+			});
+		});
+
+		for (size_t i = 0; i < functions.size(); i++)
+		{
+			calls[functions[i]->name.name].merge(callees[i]);
+		}
+	}
+
+	bool CallGraph::contains(const std::string& name) const
+	{
+		return calls.find(name) != calls.end();
+	}
+
+	std::unordered_set<std::string> CallGraph::reachableFrom(const std::string& root) const
+	{
+		std::unordered_set<std::string> reachable;
+
+		if (contains(root) == false) { return reachable; }
+
+		// Depth first search without recursion so long call chains cannot overflow the stack
+		std::vector<const std::string*> stack = { &root };
+		reachable.insert(root);
+
+		while (stack.empty() == false)
+		{
+			const std::string& name = *stack.back();
+			stack.pop_back();
+
+			for (const std::string& callee : calls.at(name))
+			{
+				// Functions outside of the project have no calls to follow
+				if (contains(callee) && reachable.insert(callee).second)
+				{
+					stack.push_back(&callee);
+				}
+			}
+		}
+
+		return reachable;
+	}
+
+	bool CallGraph::isRecursive(const std::string& name) const
+	{
+		if (contains(name) == false) { return false; }
+
+		for (const std::string& callee : calls.at(name))
+		{
+			if (callee == name) { return true; }
+
+			if (contains(callee) && reachableFrom(callee).count(name) != 0) { return true; }
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,690 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <compile-time-calls.h>
+
+#include <common.h>
+
+namespace LX::Optimizer
+{
+	using LX::Lexer::TokenType;
+
+	// Only the types that can be stored in a Constant are evaluated
+	static bool isSupportedType(const std::string& type)
+	{
+		return type == "int" || type == "string" || type == "std::string";
+	}
+
+	CompileTimeEvaluator::CompileTimeEvaluator(const std::vector<LX::Parser::FunctionDeclaration*>& project)
+	{
+		std::unordered_set<std::string> overloaded;
+
+		for (const LX::Parser::FunctionDeclaration* func : project)
+		{
+			if (functions.emplace(func->name.name, func).second == false)
+			{
+				overloaded.insert(func->name.name);
+			}
+		}
+
+		for (const std::string& name : overloaded)
+		{
+			functions.erase(name);
+		}
+	}
+
+	Constant CompileTimeEvaluator::evaluate(const LX::Parser::FunctionCall* call)
+	{
+		error.clear();
+		stepsLeft = STEP_LIMIT;
+		depth = 0;
+
+		// Arguments are literals so no variables are needed
+		Frame frame;
+		frame.scopes.emplace_back();
+
+		return evaluateExpression(call, frame);
+	}
+
+	bool CompileTimeEvaluator::step()
+	{
+		if (stepsLeft == 0) { return false; }
+
+		stepsLeft--;
+		return true;
+	}
+
+	bool CompileTimeEvaluator::store(Variable& var, const Constant& value)
+	{
+		if (value.isKnown() == false) { return false; }
+
+		if (var.isString)
+		{
+			if (value.type != Constant::Type::STRING) { return false; }
+
+			var.value = value;
+			return true;
+		}
+
+		// Bools are converted to ints the same as in C++
+		if (value.type == Constant::Type::STRING) { return false; }
+
+		var.value = Constant::fromInt(value.intValue);
+		return true;
+	}
+
+	Constant CompileTimeEvaluator::call(const LX::Parser::FunctionDeclaration& func, const std::vector<Constant>& args)
+	{
+		using namespace LX::Parser;
+
+		// Functions with more than one (or no) return value have no result that can be stored in a Constant
+		if (func.returnTypes.size() != 1 || isSupportedType(func.returnTypes[0].name) == false) { return Constant(); }
+		if (func.args.size() != args.size() || depth == DEPTH_LIMIT) { return Constant(); }
+
+		Frame frame;
+		frame.scopes.emplace_back();
+
+		for (size_t i = 0; i < args.size(); i++)
+		{
+			const VariableDeclaration* param = static_cast<const VariableDeclaration*>(func.args[i].get());
+
+			// A (non const) reference parameter could be used to change the caller's variables
+			if (isSupportedType(param->varType.name) == false || param->isPointer() || (param->isReference() && param->isConst() == false)) { return Constant(); }
+
+			Variable var;
+			var.isString = param->varType.name == "string";
+
+			if (store(var, args[i]) == false) { return Constant(); }
+
+			frame.scopes.back()[param->name.name] = var;
+		}
+
+		depth++;
+		Flow flow = runBlock(func.body, frame);
+		depth--;
+
+		// Reaching the end of a function without returning a value is undefined in C++
+		if (flow != Flow::RETURN) { return Constant(); }
+
+		Variable result;
+		result.isString = func.returnTypes[0].name == "std::string";
+
+		return store(result, frame.returnValue) ? result.value : Constant();
+	}
+
+	CompileTimeEvaluator::Flow CompileTimeEvaluator::runBlock(const LX::Parser::AST& body, Frame& frame)
+	{
+		frame.scopes.emplace_back();
+
+		Flow flow = Flow::NEXT;
+
+		for (const std::unique_ptr<LX::Parser::ASTNode>& statement : body)
+		{
+			flow = runStatement(statement.get(), frame);
+
+			if (flow != Flow::NEXT) { break; }
+		}
+
+		frame.scopes.pop_back();
+		return flow;
+	}
+
+	CompileTimeEvaluator::Flow CompileTimeEvaluator::runStatement(const LX::Parser::ASTNode* node, Frame& frame)
+	{
+		using namespace LX::Parser;
+
+		// Nodes can be null after a parser error
+		if (node == nullptr || step() == false) { return Flow::FAIL; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+			{
+				const VariableDeclaration* varDecl = static_cast<const VariableDeclaration*>(node);
+
+				// Static variables keep their value between calls and references could point to anything
+				if (isSupportedType(varDecl->varType.name) == false || varDecl->isReference() || varDecl->isPointer()) { return Flow::FAIL; }
+				if (varDecl->isStatic() && varDecl->isConst() == false) { return Flow::FAIL; }
+
+				Variable var;
+				var.isString = varDecl->varType.name == "string";
+
+				if (varDecl->val != nullptr)
+				{
+					if (store(var, evaluateExpression(varDecl->val->val.get(), frame)) == false) { return Flow::FAIL; }
+				}
+
+				// An int without a value is left unknown (reading it is undefined in C++) but a string starts empty
+				else if (var.isString)
+				{
+					var.value = Constant::fromString("");
+				}
+
+				frame.scopes.back()[varDecl->name.name] = var;
+				return Flow::NEXT;
+			}
+
+			case ASTNode::NodeType::ASSIGNMENT:
+			{
+				const Assignment* assignment = static_cast<const Assignment*>(node);
+
+				Variable* var = findVariable(assignment->name.name, frame);
+
+				if (var == nullptr || store(*var, evaluateExpression(assignment->val.get(), frame)) == false) { return Flow::FAIL; }
+
+				return Flow::NEXT;
+			}
+
+			case ASTNode::NodeType::IF_STATEMENT:
+			{
+				const IfStatement* ifStatement = static_cast<const IfStatement*>(node);
+
+				while (ifStatement != nullptr)
+				{
+					if (ifStatement->type != IfStatement::IfType::ELSE)
+					{
+						Constant condition = evaluateExpression(ifStatement->condition.get(), frame);
+
+						if (condition.isKnown() == false || condition.type == Constant::Type::STRING) { return Flow::FAIL; }
+
+						if (condition.intValue == 0)
+						{
+							ifStatement = ifStatement->next.get();
+							continue;
+						}
+					}
+
+					return runBlock(ifStatement->body, frame);
+				}
+
+				return Flow::NEXT;
+			}
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				return runLoop(static_cast<const LoopStatement*>(node), frame);
+			}
+
+			case ASTNode::NodeType::JUMP_STATEMENT:
+			{
+				return static_cast<const JumpStatement*>(node)->jumpType == JumpStatement::JumpType::BREAK ? Flow::BREAK : Flow::CONTINUE;
+			}
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+			{
+				frame.returnValue = evaluateExpression(static_cast<const ReturnStatement*>(node)->expr.get(), frame);
+
+				return frame.returnValue.isKnown() ? Flow::RETURN : Flow::FAIL;
+			}
+
+			// Every value returned by a call is needed which is only possible for a single value
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+			{
+				return Flow::FAIL;
+			}
+
+			default:
+			{
+				return evaluateExpression(node, frame).isKnown() ? Flow::NEXT : Flow::FAIL;
+			}
+		}
+	}
+
+	CompileTimeEvaluator::Flow CompileTimeEvaluator::runLoop(const LX::Parser::LoopStatement* loop, Frame& frame)
+	{
+		// A variable declared by the init is only visible inside the loop
+		frame.scopes.emplace_back();
+
+		Flow flow = loop->init != nullptr ? runStatement(loop->init.get(), frame) : Flow::NEXT;
+
+		while (flow == Flow::NEXT)
+		{
+			// Every iteration is a step so a loop that does nothing still reaches the limit
+			if (step() == false)
+			{
+				flow = Flow::FAIL;
+				break;
+			}
+
+			// A loop without a condition only ends with a break or return
+			if (loop->condition != nullptr)
+			{
+				Constant condition = evaluateExpression(loop->condition.get(), frame);
+
+				if (condition.isKnown() == false || condition.type == Constant::Type::STRING)
+				{
+					flow = Flow::FAIL;
+					break;
+				}
+
+				if (condition.intValue == 0) { break; }
+			}
+
+			flow = runBlock(loop->body, frame);
+
+			if (flow == Flow::BREAK)
+			{
+				flow = Flow::NEXT;
+				break;
+			}
+
+			if (flow == Flow::CONTINUE) { flow = Flow::NEXT; }
+
+			if (flow == Flow::NEXT && loop->step != nullptr)
+			{
+				flow = runStatement(loop->step.get(), frame);
+			}
+		}
+
+		frame.scopes.pop_back();
+		return flow;
+	}
+
+	CompileTimeEvaluator::Variable* CompileTimeEvaluator::findVariable(const std::string& name, Frame& frame)
+	{
+		// Inner scopes hide outer ones
+		for (auto scope = frame.scopes.rbegin(); scope != frame.scopes.rend(); scope++)
+		{
+			if (auto it = scope->find(name); it != scope->end())
+			{
+				return &it->second;
+			}
+		}
+
+		return nullptr;
+	}
+
+	CompileTimeEvaluator::Variable* CompileTimeEvaluator::findVariable(const ExpressionView& tree, Frame& frame)
+	{
+		if (tree.kind != Expression::Kind::LEAF || tree.leaf->type != LX::Parser::ASTNode::NodeType::IDENTIFIER) { return nullptr; }
+
+		return findVariable(static_cast<const LX::Parser::Identifier*>(tree.leaf)->name, frame);
+	}
+
+	Constant CompileTimeEvaluator::evaluateExpression(const LX::Parser::ASTNode* node, Frame& frame)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr || step() == false) { return Constant(); }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				Constant value = literalValue(node);
+
+				if (value.isKnown()) { return value; }
+
+				// Variables without a value are left unknown
+				Variable* var = findVariable(static_cast<const Identifier*>(node)->name, frame);
+
+				return var != nullptr ? var->value : Constant();
+			}
+
+			case ASTNode::NodeType::STRING_LITERAL:
+			{
+				return literalValue(node);
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+			{
+				return evaluateExpression(static_cast<const BracketedExpression*>(node)->expr.get(), frame);
+			}
+
+			case ASTNode::NodeType::OPERATION:
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				std::unique_ptr<ExpressionView> tree = viewTree(node);
+
+				// The parser failed on part of the expression
+				if (tree == nullptr) { return Constant(); }
+
+				return evaluateTree(*tree, frame);
+			}
+
+			// Calls to anything that is not a function of the project (such as the core functions) are never evaluated
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				const FunctionCall* functionCall = static_cast<const FunctionCall*>(node);
+
+				auto it = functions.find(functionCall->funcName.name);
+
+				if (it == functions.end()) { return Constant(); }
+
+				std::vector<Constant> args;
+
+				for (const std::unique_ptr<ASTNode>& arg : functionCall->args)
+				{
+					args.push_back(evaluateExpression(arg.get(), frame));
+
+					if (args.back().isKnown() == false) { return Constant(); }
+				}
+
+				return call(*it->second, args);
+			}
+
+			default:
+			{
+				return Constant();
+			}
+		}
+	}
+
+	// The operator that is applied by an assignment operator (such as + for +=)
+	static TokenType assignedOperator(TokenType op)
+	{
+		switch (op)
+		{
+			case TokenType::PLUS_EQUALS: return TokenType::PLUS;
+			case TokenType::MINUS_EQUALS: return TokenType::MINUS;
+			case TokenType::MULTIPLY_EQUALS: return TokenType::MULTIPLY;
+			case TokenType::DIVIDE_EQUALS: return TokenType::DIVIDE;
+			default: return TokenType::UNDEFINED;
+		}
+	}
+
+	// Returns true if the string is the same in the source as it is at runtime (it has no escape sequences)
+	static bool isPlainString(const Constant& value)
+	{
+		return value.stringValue.find('\\') == std::string::npos;
+	}
+
+	static bool isStringLiteral(const ExpressionView& tree)
+	{
+		return tree.kind == Expression::Kind::LEAF && tree.leaf->type == LX::Parser::ASTNode::NodeType::STRING_LITERAL;
+	}
+
+	Constant CompileTimeEvaluator::evaluateTree(const ExpressionView& tree, Frame& frame)
+	{
+		switch (tree.kind)
+		{
+			case Expression::Kind::PREFIX:
+			case Expression::Kind::POSTFIX:
+			{
+				if (tree.op == TokenType::INCREMENT || tree.op == TokenType::DECREMENT)
+				{
+					Variable* var = findVariable(*tree.lhs, frame);
+
+					if (var == nullptr || var->isString || var->value.isKnown() == false) { return Constant(); }
+
+					Constant before = var->value;
+					Constant after = evaluateBinary(tree.op == TokenType::INCREMENT ? TokenType::PLUS : TokenType::MINUS, before, Constant::fromInt(1), error);
+
+					if (store(*var, after) == false) { return Constant(); }
+
+					return tree.kind == Expression::Kind::PREFIX ? after : before;
+				}
+
+				if (tree.kind == Expression::Kind::POSTFIX) { return Constant(); }
+
+				return evaluatePrefix(tree.op, evaluateTree(*tree.lhs, frame), error);
+			}
+
+			case Expression::Kind::BINARY:
+			{
+				if (isAssignmentOperator(tree.op))
+				{
+					// The right side of an assignment is run before the left side
+					Constant rhs = evaluateTree(*tree.rhs, frame);
+					Variable* var = findVariable(*tree.lhs, frame);
+
+					if (var == nullptr) { return Constant(); }
+
+					Constant value = evaluateBinary(assignedOperator(tree.op), var->value, rhs, error);
+
+					return store(*var, value) ? var->value : Constant();
+				}
+
+				Constant lhs = evaluateTree(*tree.lhs, frame);
+
+				if (lhs.isKnown() == false) { return Constant(); }
+
+				// The right side of && and || is only run if the left side does not decide the result
+				if (tree.op == TokenType::AND || tree.op == TokenType::OR)
+				{
+					if (lhs.type == Constant::Type::STRING) { return Constant(); }
+
+					if ((lhs.intValue != 0) == (tree.op == TokenType::OR)) { return Constant::fromBool(tree.op == TokenType::OR); }
+
+					Constant rhs = evaluateTree(*tree.rhs, frame);
+
+					if (rhs.isKnown() == false || rhs.type == Constant::Type::STRING) { return Constant(); }
+
+					return Constant::fromBool(rhs.intValue != 0);
+				}
+
+				Constant rhs = evaluateTree(*tree.rhs, frame);
+
+				if (rhs.isKnown() == false) { return Constant(); }
+
+				// Strings of variables are std::strings so (unlike two string literals) are compared by their contents
+				bool comparesStrings = lhs.type == Constant::Type::STRING && rhs.type == Constant::Type::STRING && tree.op != TokenType::PLUS;
+
+				if (comparesStrings)
+				{
+					if ((isStringLiteral(*tree.lhs) && isStringLiteral(*tree.rhs)) || isPlainString(lhs) == false || isPlainString(rhs) == false) { return Constant(); }
+
+					int order = lhs.stringValue.compare(rhs.stringValue);
+
+					switch (tree.op)
+					{
+						case TokenType::EQUALS: return Constant::fromBool(order == 0);
+						case TokenType::NOT_EQUALS: return Constant::fromBool(order != 0);
+						case TokenType::LESS_THAN: return Constant::fromBool(order < 0);
+						case TokenType::LESS_THAN_EQUALS: return Constant::fromBool(order <= 0);
+						case TokenType::GREATER_THAN: return Constant::fromBool(order > 0);
+						case TokenType::GREATER_THAN_EQUALS: return Constant::fromBool(order >= 0);
+						default: return Constant();
+					}
+				}
+
+				return evaluateBinary(tree.op, lhs, rhs, error);
+			}
+
+			default:
+			{
+				return evaluateExpression(tree.leaf, frame);
+			}
+		}
+	}
+
+	// Replaces the calls below a node (and the node itself) with their results
+	class CallReplacer
+	{
+		private:
+			CompileTimeEvaluator& evaluator;
+			const std::string& functionName;
+			Diagnostics& diagnostics;
+
+		public:
+			std::vector<std::string> replaced;
+
+			CallReplacer(CompileTimeEvaluator& evaluator, const std::string& functionName, Diagnostics& diagnostics)
+				: evaluator(evaluator), functionName(functionName), diagnostics(diagnostics) {}
+
+			void replaceBlock(LX::Parser::AST& body)
+			{
+				for (std::unique_ptr<LX::Parser::ASTNode>& statement : body)
+				{
+					replaceStatement(statement);
+				}
+			}
+
+			void replaceStatement(std::unique_ptr<LX::Parser::ASTNode>& node)
+			{
+				using namespace LX::Parser;
+
+				if (node == nullptr) { return; }
+
+				switch (node->type)
+				{
+					case ASTNode::NodeType::VARIABLE_DECLARATION:
+					{
+						VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(node.get());
+
+						if (varDecl->val != nullptr) { replace(varDecl->val->val, true); }
+						return;
+					}
+
+					case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+						replace(static_cast<DestructuringDeclaration*>(node.get())->val, false);
+						return;
+
+					case ASTNode::NodeType::ASSIGNMENT:
+						replace(static_cast<Assignment*>(node.get())->val, true);
+						return;
+
+					case ASTNode::NodeType::IF_STATEMENT:
+					{
+						IfStatement* ifStatement = static_cast<IfStatement*>(node.get());
+
+						while (ifStatement != nullptr)
+						{
+							replace(ifStatement->condition, false);
+							replaceBlock(ifStatement->body);
+
+							ifStatement = ifStatement->next.get();
+						}
+
+						return;
+					}
+
+					case ASTNode::NodeType::LOOP_STATEMENT:
+					{
+						LoopStatement* loopStatement = static_cast<LoopStatement*>(node.get());
+
+						replaceStatement(loopStatement->init);
+						replace(loopStatement->condition, false);
+						replaceBlock(loopStatement->body);
+						replaceStatement(loopStatement->step);
+
+						return;
+					}
+
+					case ASTNode::NodeType::RETURN_STATEMENT:
+						replace(static_cast<ReturnStatement*>(node.get())->expr, true);
+						return;
+
+					// A call on its own is only run for what it does so is never replaced (only its arguments are)
+					case ASTNode::NodeType::FUNCTION_CALL:
+						for (std::unique_ptr<ASTNode>& arg : static_cast<FunctionCall*>(node.get())->args)
+						{
+							replace(arg, true);
+						}
+
+						return;
+
+					default:
+						replace(node, false);
+						return;
+				}
+			}
+
+			// isValue is set where a string literal is converted to a std::string (or printed) the same as the result would be
+			void replace(std::unique_ptr<LX::Parser::ASTNode>& node, bool isValue)
+			{
+				using namespace LX::Parser;
+
+				if (node == nullptr) { return; }
+
+				switch (node->type)
+				{
+					case ASTNode::NodeType::OPERATION:
+						replace(static_cast<Operation*>(node.get())->lhs, false);
+						replace(static_cast<Operation*>(node.get())->rhs, false);
+						return;
+
+					case ASTNode::NodeType::UNARY_OPERATION:
+						replace(static_cast<UnaryOperation*>(node.get())->val, false);
+						return;
+
+					case ASTNode::NodeType::BRACKETED_EXPRESSION:
+						replace(static_cast<BracketedExpression*>(node.get())->expr, false);
+						return;
+
+					case ASTNode::NodeType::TUPLE_EXPRESSION:
+						for (std::unique_ptr<ASTNode>& value : static_cast<TupleExpression*>(node.get())->values)
+						{
+							replace(value, true);
+						}
+
+						return;
+
+					case ASTNode::NodeType::FUNCTION_CALL:
+					{
+						FunctionCall* functionCall = static_cast<FunctionCall*>(node.get());
+						bool literalArgs = true;
+
+						// Arguments are replaced first so calls that are passed to other calls are evaluated from the inside out
+						for (std::unique_ptr<ASTNode>& arg : functionCall->args)
+						{
+							replace(arg, true);
+							literalArgs = literalArgs && literalValue(arg.get()).isKnown();
+						}
+
+						if (literalArgs == false) { return; }
+
+						Constant value = evaluator.evaluate(functionCall);
+
+						if (evaluator.error.empty() == false)
+						{
+							diagnostics.warnings.push_back(evaluator.error + " in a call to " + functionCall->funcName.name + " in function: " + functionName);
+						}
+
+						if (value.isKnown() && (isValue || value.type != Constant::Type::STRING))
+						{
+							replaced.push_back(functionCall->funcName.name);
+							node = makeLiteral(value);
+						}
+
+						return;
+					}
+
+					default:
+						return;
+				}
+			}
+	};
+
+	std::vector<std::string> replaceCompileTimeCalls(LX::Parser::FunctionDeclaration& func, CompileTimeEvaluator& evaluator, Diagnostics& out)
+	{
+		CallReplacer replacer(evaluator, func.name.name, out);
+		replacer.replaceBlock(func.body);
+
+		return replacer.replaced;
+	}
+}
@@ -0,0 +1,363 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <constant-folding.h>
+
+#include <common.h>
+
+namespace LX::Optimizer
+{
+	using LX::Lexer::TokenType;
+
+	void ConstantFolder::declare(const std::string& name, const Constant& value)
+	{
+		scopes.back()[name] = value;
+	}
+
+	Constant ConstantFolder::lookup(const std::string& name) const
+	{
+		// Inner scopes hide outer ones
+		for (auto scope = scopes.rbegin(); scope != scopes.rend(); scope++)
+		{
+			if (auto it = scope->find(name); it != scope->end())
+			{
+				return it->second;
+			}
+		}
+
+		return Constant();
+	}
+
+	void ConstantFolder::warn(const std::string& message)
+	{
+		diagnostics->warnings.push_back(message + " in function: " + *functionName);
+	}
+
+	void ConstantFolder::fold(LX::Parser::FunctionDeclaration& func, Diagnostics& out)
+	{
+		functionName = &func.name.name;
+		diagnostics = &out;
+
+		scopes.clear();
+		scopes.emplace_back();
+
+		// Arguments are never constant
+		for (const std::unique_ptr<LX::Parser::ASTNode>& arg : func.args)
+		{
+			declare(static_cast<LX::Parser::VariableDeclaration*>(arg.get())->name.name, Constant());
+		}
+
+		for (std::unique_ptr<LX::Parser::ASTNode>& statement : func.body)
+		{
+			foldStatement(statement);
+		}
+
+		scopes.clear();
+	}
+
+	void ConstantFolder::foldBlock(LX::Parser::AST& body)
+	{
+		scopes.emplace_back();
+
+		for (std::unique_ptr<LX::Parser::ASTNode>& statement : body)
+		{
+			foldStatement(statement);
+		}
+
+		scopes.pop_back();
+	}
+
+	void ConstantFolder::foldStatement(std::unique_ptr<LX::Parser::ASTNode>& node)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+			{
+				VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(node.get());
+
+				Constant value;
+
+				if (varDecl->val != nullptr)
+				{
+					value = foldExpression(varDecl->val->val);
+				}
+
+				// Only const ints are replaced with their value
+				// A string literal is not a std::string in C++ so replacing a string variable could change what the code means
+				if (varDecl->isConst() && varDecl->varType.name == "int" && value.isKnown() && value.type != Constant::Type::STRING)
+				{
+					declare(varDecl->name.name, Constant::fromInt(value.intValue));
+				}
+
+				else
+				{
+					declare(varDecl->name.name, Constant());
+				}
+
+				return;
+			}
+
+			// The returned values are never known
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+			{
+				DestructuringDeclaration* destructuring = static_cast<DestructuringDeclaration*>(node.get());
+
+				foldExpression(destructuring->val);
+
+				for (std::unique_ptr<VariableDeclaration>& var : destructuring->vars)
+				{
+					declare(var->name.name, Constant());
+				}
+
+				return;
+			}
+
+			case ASTNode::NodeType::ASSIGNMENT:
+			{
+				foldExpression(static_cast<Assignment*>(node.get())->val);
+				return;
+			}
+
+			case ASTNode::NodeType::IF_STATEMENT:
+			{
+				IfStatement* ifStatement = static_cast<IfStatement*>(node.get());
+
+				while (ifStatement != nullptr)
+				{
+					foldExpression(ifStatement->condition);
+					foldBlock(ifStatement->body);
+
+					ifStatement = ifStatement->next.get();
+				}
+
+				return;
+			}
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(node.get());
+
+				// A variable declared by the init is only visible inside the loop
+				scopes.emplace_back();
+
+				foldStatement(loopStatement->init);
+				foldExpression(loopStatement->condition);
+				foldBlock(loopStatement->body);
+				foldStatement(loopStatement->step);
+
+				scopes.pop_back();
+
+				return;
+			}
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+			{
+				foldExpression(static_cast<ReturnStatement*>(node.get())->expr);
+				return;
+			}
+
+			default:
+			{
+				foldExpression(node);
+				return;
+			}
+		}
+	}
+
+	Constant ConstantFolder::foldExpression(std::unique_ptr<LX::Parser::ASTNode>& node, bool isLValue)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return Constant(); }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				Constant value = literalValue(node.get());
+
+				if (value.isKnown() || isLValue) { return value; }
+
+				value = lookup(static_cast<Identifier*>(node.get())->name);
+
+				if (value.isKnown())
+				{
+					node = makeLiteral(value);
+					propagated++;
+				}
+
+				return value;
+			}
+
+			case ASTNode::NodeType::STRING_LITERAL:
+			{
+				return literalValue(node.get());
+			}
+
+			case ASTNode::NodeType::OPERATION:
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				std::unique_ptr<Expression> tree = toTree(node);
+
+				// The parser failed on part of the expression
+				if (tree == nullptr) { return Constant(); }
+
+				Constant value = foldTree(*tree, isLValue);
+				node = fromTree(std::move(tree));
+
+				return value;
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+			{
+				BracketedExpression* brackets = static_cast<BracketedExpression*>(node.get());
+
+				Constant value = foldExpression(brackets->expr, isLValue);
+
+				// A literal does not need brackets
+				if (value.isKnown() && isLValue == false)
+				{
+					node = std::move(brackets->expr);
+				}
+
+				return value;
+			}
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				for (std::unique_ptr<ASTNode>& arg : static_cast<FunctionCall*>(node.get())->args)
+				{
+					foldExpression(arg);
+				}
+
+				return Constant();
+			}
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+			{
+				for (std::unique_ptr<ASTNode>& value : static_cast<TupleExpression*>(node.get())->values)
+				{
+					foldExpression(value);
+				}
+
+				return Constant();
+			}
+
+			default:
+			{
+				return Constant();
+			}
+		}
+	}
+
+	Constant ConstantFolder::foldTree(Expression& tree, bool isLValue)
+	{
+		switch (tree.kind)
+		{
+			case Expression::Kind::PREFIX:
+			case Expression::Kind::POSTFIX:
+			{
+				// Increments and decrements change their operand
+				bool changesOperand = tree.op == TokenType::INCREMENT || tree.op == TokenType::DECREMENT;
+
+				Constant operand = foldTree(*tree.lhs, changesOperand);
+
+				if (tree.kind == Expression::Kind::POSTFIX || changesOperand) { return Constant(); }
+
+				std::string error;
+				Constant value = evaluatePrefix(tree.op, operand, error);
+
+				if (error.empty() == false) { warn(error); }
+
+				if (value.isKnown())
+				{
+					tree.makeLeaf(makeLiteral(value));
+					folded++;
+				}
+
+				return value;
+			}
+
+			case Expression::Kind::BINARY:
+			{
+				bool assigns = isAssignmentOperator(tree.op);
+
+				Constant lhs = foldTree(*tree.lhs, assigns);
+
+				// The right side of && and || is not run if the left side decides the result
+				// Nothing is lost by removing it as the C++ code would not run it either
+				bool isKnownNumber = lhs.isKnown() && lhs.type != Constant::Type::STRING;
+
+				if (isKnownNumber && ((tree.op == TokenType::AND && lhs.intValue == 0) || (tree.op == TokenType::OR && lhs.intValue != 0)))
+				{
+					Constant value = Constant::fromBool(tree.op == TokenType::OR);
+
+					tree.makeLeaf(makeLiteral(value));
+					folded++;
+
+					return value;
+				}
+
+				Constant rhs = foldTree(*tree.rhs, false);
+
+				if (assigns) { return Constant(); }
+
+				std::string error;
+				Constant value = evaluateBinary(tree.op, lhs, rhs, error);
+
+				if (error.empty() == false) { warn(error); }
+
+				if (value.isKnown())
+				{
+					tree.makeLeaf(makeLiteral(value));
+					folded++;
+				}
+
+				return value;
+			}
+
+			default:
+			{
+				return foldExpression(tree.leaf, isLValue);
+			}
+		}
+	}
+}
@@ -0,0 +1,97 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <dead-functions.h>
+
+#include <common.h>
+
+#include <call-graph.h>
+
+namespace LX::Optimizer
+{
+	size_t eliminateDeadFunctions(const std::vector<LX::Parser::FileAST*>& files, Diagnostics& out)
+	{
+		CallGraph graph;
+		graph.build(files);
+
+		if (graph.contains("main") == false)
+		{
+			out.notes.push_back("Dead function elimination: skipped as the project has no main function");
+			return 0;
+		}
+
+		std::unordered_set<std::string> reachable = graph.reachableFrom("main");
+
+		// Names of the removed functions (in declaration order)
+		std::vector<std::string> removed;
+		size_t total = 0;
+
+		for (LX::Parser::FileAST* file : files)
+		{
+			std::vector<LX::Parser::FunctionDeclaration>& functions = file->functions;
+			total += functions.size();
+
+			// Nodes cannot be assigned to so the functions that are kept are moved to a new list instead of being erased
+			std::vector<LX::Parser::FunctionDeclaration> kept;
+			kept.reserve(functions.size());
+
+			for (LX::Parser::FunctionDeclaration& func : functions)
+			{
+				if (reachable.find(func.name.name) != reachable.end())
+				{
+					kept.push_back(std::move(func));
+				}
+
+				else
+				{
+					removed.push_back(func.name.name);
+				}
+			}
+
+			functions = std::move(kept);
+		}
+
+		out.notes.push_back("Dead function elimination: removed " + std::to_string(removed.size()) + " of " + std::to_string(total) + " functions");
+
+		for (const std::string& name : removed)
+		{
+			out.notes.push_back("    Unreachable from main: " + name);
+		}
+
+		return removed.size();
+	}
+}
@@ -0,0 +1,404 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <dead-stores.h>
+
+#include <common.h>
+
+#include <ast-walk.h>
+#include <expression.h>
+
+namespace LX::Optimizer
+{
+	using LX::Lexer::TokenType;
+
+	static bool hasSideEffects(LX::Parser::ASTNode* node)
+	{
+		using namespace LX::Parser;
+
+		bool out = false;
+
+		walk(node, [&](ASTNode* child)
+		{
+			switch (child->type)
+			{
+				// Functions are assumed to always have side effects
+				case ASTNode::NodeType::FUNCTION_CALL:
+				case ASTNode::NodeType::ASSIGNMENT:
+					out = true;
+					return;
+
+				case ASTNode::NodeType::OPERATION:
+					out = out || isAssignmentOperator(static_cast<Operation*>(child)->op);
+					return;
+
+				case ASTNode::NodeType::UNARY_OPERATION:
+				{
+					TokenType op = static_cast<UnaryOperation*>(child)->op;
+					out = out || op == TokenType::INCREMENT || op == TokenType::DECREMENT;
+					return;
+				}
+
+				default:
+					return;
+			}
+		});
+
+		return out;
+	}
+
+	// Returns what is left of a removed store, which is its value if it has side effects (or nullptr if it has none)
+	// The value is kept as an expression statement so the side effects still happen in the same order
+	static std::unique_ptr<LX::Parser::ASTNode> keepSideEffects(std::unique_ptr<LX::Parser::ASTNode> value)
+	{
+		if (hasSideEffects(value.get()) == false) { return nullptr; }
+
+		return value;
+	}
+
+	// Adds every variable read by the node to the set
+	static void addUses(LX::Parser::ASTNode* node, std::unordered_set<std::string>& live)
+	{
+		walk(node, [&](LX::Parser::ASTNode* child)
+		{
+			if (child->type == LX::Parser::ASTNode::NodeType::IDENTIFIER)
+			{
+				live.insert(static_cast<LX::Parser::Identifier*>(child)->name);
+			}
+		});
+	}
+
+	// Returns the name of the variable if the node is a variable (or nullptr)
+	static const std::string* variableName(LX::Parser::ASTNode* node)
+	{
+		if (node == nullptr || node->type != LX::Parser::ASTNode::NodeType::IDENTIFIER) { return nullptr; }
+
+		return &static_cast<LX::Parser::Identifier*>(node)->name;
+	}
+
+	void DeadStoreEliminator::countReferences(LX::Parser::FunctionDeclaration& func)
+	{
+		references.clear();
+
+		walk(func, [&](LX::Parser::ASTNode* node)
+		{
+			if (node->type == LX::Parser::ASTNode::NodeType::IDENTIFIER)
+			{
+				references[static_cast<LX::Parser::Identifier*>(node)->name]++;
+			}
+
+			// The value of a declaration is an assignment without a name
+			else if (node->type == LX::Parser::ASTNode::NodeType::ASSIGNMENT)
+			{
+				const std::string& name = static_cast<LX::Parser::Assignment*>(node)->name.name;
+
+				if (name.empty() == false) { references[name]++; }
+			}
+		});
+	}
+
+	void DeadStoreEliminator::findAliased(LX::Parser::FunctionDeclaration& func)
+	{
+		using namespace LX::Parser;
+
+		aliased.clear();
+
+		// Writes to a reference parameter are seen by the caller
+		for (std::unique_ptr<ASTNode>& arg : func.args)
+		{
+			VariableDeclaration* param = static_cast<VariableDeclaration*>(arg.get());
+
+			if (param->isReference()) { aliased.insert(param->name.name); }
+		}
+
+		// A reference variable and the variable it refers to are the same variable under two names
+		walk(func, [&](ASTNode* node)
+		{
+			if (node->type != ASTNode::NodeType::VARIABLE_DECLARATION) { return; }
+
+			VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(node);
+
+			// The value of a (non const) static variable is kept for the next call of the function
+			if (varDecl->isStatic() && varDecl->isConst() == false) { aliased.insert(varDecl->name.name); }
+
+			if (varDecl->isReference() == false) { return; }
+
+			aliased.insert(varDecl->name.name);
+
+			if (varDecl->val != nullptr)
+			{
+				if (const std::string* name = variableName(varDecl->val->val.get()); name != nullptr) { aliased.insert(*name); }
+			}
+		});
+	}
+
+	bool DeadStoreEliminator::isDead(const LiveSet& live, const std::string& name) const
+	{
+		return live.find(name) == live.end() && aliased.find(name) == aliased.end();
+	}
+
+	void DeadStoreEliminator::eliminate(LX::Parser::FunctionDeclaration& func)
+	{
+		findAliased(func);
+
+		// Removing a store can make the stores of the variables it read dead so it is repeated until nothing changes
+		// Nothing is live at the end of the function
+		do
+		{
+			changed = false;
+
+			countReferences(func);
+			eliminateInBlock(func.body, LiveSet(), LiveSet());
+		}
+		while (changed);
+	}
+
+	DeadStoreEliminator::LiveSet DeadStoreEliminator::eliminateInBlock(LX::Parser::AST& body, LiveSet live, const LiveSet& liveAfterBlock)
+	{
+		using namespace LX::Parser;
+
+		// Loops are handled as a whole by the LOOP_STATEMENT case so the statements of a block are always run in order
+		for (size_t i = body.size(); i-- > 0;)
+		{
+			std::unique_ptr<ASTNode>& statement = body[i];
+
+			if (statement == nullptr) { continue; }
+
+			switch (statement->type)
+			{
+				case ASTNode::NodeType::VARIABLE_DECLARATION:
+				{
+					VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(statement.get());
+
+					const std::string name = varDecl->name.name;
+					ASTNode* value = varDecl->val != nullptr ? varDecl->val->val.get() : nullptr;
+
+					// The value of a static variable is only created on the first call so it cannot be moved out of the declaration
+					bool isRemoved = isDead(live, name) && references[name] == 0 && (hasSideEffects(value) == false || varDecl->isStatic() == false);
+
+					// A variable that is always written to before it is read does not need its first value
+					// Const and reference variables must be given a value in C++
+					bool isDeadValue = isRemoved == false && value != nullptr && isDead(live, name) && varDecl->isStatic() == false && varDecl->isConst() == false && varDecl->isReference() == false;
+
+					// Before the declaration the name refers to the variable of the enclosing scope (if there is one)
+					live.erase(name);
+					if (liveAfterBlock.find(name) != liveAfterBlock.end()) { live.insert(name); }
+
+					if (isRemoved)
+					{
+						removedVariables.push_back(name);
+						addUses(value, live);
+						statement = keepSideEffects(varDecl->val != nullptr ? std::move(varDecl->val->val) : nullptr);
+						changed = true;
+					}
+
+					else if (isDeadValue)
+					{
+						removedStores++;
+						addUses(value, live);
+
+						std::unique_ptr<ASTNode> sideEffects = keepSideEffects(std::move(varDecl->val->val));
+						varDecl->val = nullptr;
+						changed = true;
+
+						// The value is kept before the declaration so the side effects happen at the same point
+						if (sideEffects != nullptr) { body.insert(body.begin() + i, std::move(sideEffects)); }
+					}
+
+					else
+					{
+						addUses(value, live);
+					}
+
+					break;
+				}
+
+				// The variables are always kept as the value has to be unpacked into all of them
+				case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+				{
+					DestructuringDeclaration* destructuring = static_cast<DestructuringDeclaration*>(statement.get());
+
+					for (std::unique_ptr<VariableDeclaration>& var : destructuring->vars)
+					{
+						live.erase(var->name.name);
+						if (liveAfterBlock.find(var->name.name) != liveAfterBlock.end()) { live.insert(var->name.name); }
+					}
+
+					addUses(destructuring->val.get(), live);
+					break;
+				}
+
+				case ASTNode::NodeType::ASSIGNMENT:
+				{
+					Assignment* assignment = static_cast<Assignment*>(statement.get());
+
+					if (isDead(live, assignment->name.name))
+					{
+						removedStores++;
+						addUses(assignment->val.get(), live);
+						statement = keepSideEffects(std::move(assignment->val));
+						changed = true;
+					}
+
+					else
+					{
+						live.erase(assignment->name.name);
+						addUses(assignment->val.get(), live);
+					}
+
+					break;
+				}
+
+				// Compound assignments (such as x += 1) read and write the variable
+				// An assignment operator has the lowest precedence so it applies to the whole statement
+				case ASTNode::NodeType::OPERATION:
+				{
+					Operation* operation = static_cast<Operation*>(statement.get());
+					const std::string* name = variableName(operation->lhs.get());
+
+					if (isAssignmentOperator(operation->op) && name != nullptr && isDead(live, *name))
+					{
+						removedStores++;
+						addUses(operation->rhs.get(), live);
+						statement = keepSideEffects(std::move(operation->rhs));
+						changed = true;
+					}
+
+					else
+					{
+						addUses(statement.get(), live);
+					}
+
+					break;
+				}
+
+				case ASTNode::NodeType::UNARY_OPERATION:
+				{
+					UnaryOperation* unary = static_cast<UnaryOperation*>(statement.get());
+					const std::string* name = variableName(unary->val.get());
+
+					bool isStore = unary->op == TokenType::INCREMENT || unary->op == TokenType::DECREMENT;
+
+					if (isStore && name != nullptr && isDead(live, *name))
+					{
+						removedStores++;
+						statement = nullptr;
+						changed = true;
+					}
+
+					else
+					{
+						addUses(statement.get(), live);
+					}
+
+					break;
+				}
+
+				case ASTNode::NodeType::IF_STATEMENT:
+				{
+					// Live at the start of the if statement is anything live at the start of any branch or read by any condition
+					LiveSet liveBefore;
+					bool hasElse = false;
+
+					for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+					{
+						liveBefore.merge(eliminateInBlock(branch->body, live, live));
+						addUses(branch->condition.get(), liveBefore);
+
+						hasElse = hasElse || branch->type == IfStatement::IfType::ELSE;
+					}
+
+					// Without an else none of the branches might be run
+					if (hasElse == false) { liveBefore.insert(live.begin(), live.end()); }
+
+					live = std::move(liveBefore);
+					break;
+				}
+
+				// The body of a loop can be run again after any of its statements
+				// So every variable read anywhere in the loop is live for the whole loop (as well as anything live after it)
+				case ASTNode::NodeType::LOOP_STATEMENT:
+				{
+					LoopStatement* loopStatement = static_cast<LoopStatement*>(statement.get());
+
+					LiveSet liveInLoop = live;
+					addUses(loopStatement, liveInLoop);
+
+					loopLive.push_back(liveInLoop);
+					eliminateInBlock(loopStatement->body, liveInLoop, liveInLoop);
+					loopLive.pop_back();
+
+					// A variable declared by the init is only visible inside the loop
+					if (loopStatement->init != nullptr && loopStatement->init->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+					{
+						const std::string& name = static_cast<VariableDeclaration*>(loopStatement->init.get())->name.name;
+
+						if (live.find(name) == live.end()) { liveInLoop.erase(name); }
+					}
+
+					live = std::move(liveInLoop);
+					break;
+				}
+
+				case ASTNode::NodeType::JUMP_STATEMENT:
+				{
+					live.insert(loopLive.back().begin(), loopLive.back().end());
+					break;
+				}
+
+				// Nothing after a return is run
+				case ASTNode::NodeType::RETURN_STATEMENT:
+				{
+					live.clear();
+					addUses(static_cast<ReturnStatement*>(statement.get())->expr.get(), live);
+					break;
+				}
+
+				default:
+				{
+					addUses(statement.get(), live);
+					break;
+				}
+			}
+		}
+
+		// Removes the statements that were set to null
+		body.erase(std::remove(body.begin(), body.end(), nullptr), body.end());
+
+		return live;
+	}
+}
@@ -0,0 +1,602 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <expression.h>
+
+#include <common.h>
+
+namespace LX::Optimizer
+{
+	using LX::Lexer::TokenType;
+
+	// LX int is translated to a C++ int
+	static constexpr long long INT_MIN_VALUE = -2147483647LL - 1;
+	static constexpr long long INT_MAX_VALUE = 2147483647LL;
+
+	Constant Constant::fromInt(long long value)
+	{
+		Constant out;
+		out.type = Type::INT;
+		out.intValue = value;
+		return out;
+	}
+
+	Constant Constant::fromBool(bool value)
+	{
+		Constant out;
+		out.type = Type::BOOL;
+		out.intValue = value ? 1 : 0;
+		return out;
+	}
+
+	Constant Constant::fromString(const std::string& value)
+	{
+		Constant out;
+		out.type = Type::STRING;
+		out.stringValue = value;
+		return out;
+	}
+
+	Constant literalValue(const LX::Parser::ASTNode* node)
+	{
+		if (node == nullptr) { return Constant(); }
+
+		if (node->type == LX::Parser::ASTNode::NodeType::STRING_LITERAL)
+		{
+			return Constant::fromString(static_cast<const LX::Parser::StringLiteral*>(node)->value);
+		}
+
+		if (node->type != LX::Parser::ASTNode::NodeType::IDENTIFIER) { return Constant(); }
+
+		// Numbers are stored as identifiers
+		const std::string& name = static_cast<const LX::Parser::Identifier*>(node)->name;
+
+		if (name == "true") { return Constant::fromBool(true); }
+		if (name == "false") { return Constant::fromBool(false); }
+
+		size_t start = (!name.empty() && name[0] == '-') ? 1 : 0;
+		size_t digits = name.size() - start;
+
+		// Numbers with leading zeros are octal in C++ so are left alone
+		if (digits == 0 || digits > 10 || (name[start] == '0' && digits != 1)) { return Constant(); }
+
+		long long value = 0;
+
+		for (size_t i = start; i < name.size(); i++)
+		{
+			if (name[i] < '0' || name[i] > '9') { return Constant(); }
+			value = value * 10 + (name[i] - '0');
+		}
+
+		if (start == 1) { value = -value; }
+
+		// Bigger numbers would have a different type in C++
+		if (value < INT_MIN_VALUE || value > INT_MAX_VALUE) { return Constant(); }
+
+		return Constant::fromInt(value);
+	}
+
+	std::unique_ptr<LX::Parser::ASTNode> makeLiteral(const Constant& value)
+	{
+		switch (value.type)
+		{
+			case Constant::Type::INT:
+				return std::make_unique<LX::Parser::Identifier>(std::to_string(value.intValue));
+
+			case Constant::Type::BOOL:
+				return std::make_unique<LX::Parser::Identifier>(value.intValue != 0 ? "true" : "false");
+
+			case Constant::Type::STRING:
+				return std::make_unique<LX::Parser::StringLiteral>(value.stringValue);
+
+			default:
+				return nullptr;
+		}
+	}
+
+	static bool isHexDigit(char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
+	static bool isOctalDigit(char c) { return c >= '0' && c <= '7'; }
+
+	// Two string literals can only be joined if the escape sequence at the end of the first does not continue into the second
+	// For example "\x4" "1" is two characters but "\x41" is one
+	static bool canJoinStrings(const std::string& lhs, const std::string& rhs)
+	{
+		if (rhs.empty()) { return true; }
+
+		size_t i = 0;
+
+		while (i < lhs.size())
+		{
+			if (lhs[i] != '\\') { i++; continue; }
+
+			// A backslash at the end would escape the first character of the other string
+			if (i + 1 == lhs.size()) { return false; }
+
+			char type = lhs[i + 1];
+			i += 2;
+
+			// Hex escapes continue for as many hex digits as there are
+			if (type == 'x')
+			{
+				while (i < lhs.size() && isHexDigit(lhs[i])) { i++; }
+				if (i == lhs.size() && isHexDigit(rhs[0])) { return false; }
+			}
+
+			// Octal escapes are up to three digits
+			else if (isOctalDigit(type))
+			{
+				size_t length = 1;
+				while (i < lhs.size() && length < 3 && isOctalDigit(lhs[i])) { i++; length++; }
+				if (i == lhs.size() && length < 3 && isOctalDigit(rhs[0])) { return false; }
+			}
+		}
+
+		return true;
+	}
+
+	// Checks that the result of integer arithmetic fits in an int
+	static Constant checkedInt(long long value, std::string& error)
+	{
+		if (value < INT_MIN_VALUE || value > INT_MAX_VALUE)
+		{
+			error = "Integer overflow in a constant expression (" + std::to_string(value) + " does not fit in an int)";
+			return Constant();
+		}
+
+		// The smallest int cannot be written as a single literal so it is left to the C++ compiler
+		if (value == INT_MIN_VALUE) { return Constant(); }
+
+		return Constant::fromInt(value);
+	}
+
+	Constant evaluateBinary(TokenType op, const Constant& lhs, const Constant& rhs, std::string& error)
+	{
+		if (!lhs.isKnown() || !rhs.isKnown()) { return Constant(); }
+
+		using Type = Constant::Type;
+
+		// Only string literals being added are joined
+		// Anything else (such as comparing them) would be done on pointers by the C++ code
+		if (lhs.type == Type::STRING || rhs.type == Type::STRING)
+		{
+			if (op == TokenType::PLUS && lhs.type == Type::STRING && rhs.type == Type::STRING && canJoinStrings(lhs.stringValue, rhs.stringValue))
+			{
+				return Constant::fromString(lhs.stringValue + rhs.stringValue);
+			}
+
+			return Constant();
+		}
+
+		// Bools are promoted to ints the same as in C++
+		long long a = lhs.intValue;
+		long long b = rhs.intValue;
+
+		switch (op)
+		{
+			case TokenType::PLUS: return checkedInt(a + b, error);
+			case TokenType::MINUS: return checkedInt(a - b, error);
+			case TokenType::MULTIPLY: return checkedInt(a * b, error);
+
+			// C++ integer division rounds towards zero which is the same as long long division
+			case TokenType::DIVIDE:
+			case TokenType::MODULO:
+				if (b == 0)
+				{
+					error = "Division by zero in a constant expression";
+					return Constant();
+				}
+
+				return checkedInt(op == TokenType::DIVIDE ? a / b : a % b, error);
+
+			case TokenType::EQUALS: return Constant::fromBool(a == b);
+			case TokenType::NOT_EQUALS: return Constant::fromBool(a != b);
+			case TokenType::LESS_THAN: return Constant::fromBool(a < b);
+			case TokenType::LESS_THAN_EQUALS: return Constant::fromBool(a <= b);
+			case TokenType::GREATER_THAN: return Constant::fromBool(a > b);
+			case TokenType::GREATER_THAN_EQUALS: return Constant::fromBool(a >= b);
+
+			case TokenType::AND: return Constant::fromBool(a != 0 && b != 0);
+			case TokenType::OR: return Constant::fromBool(a != 0 || b != 0);
+
+			default:
+				return Constant();
+		}
+	}
+
+	Constant evaluatePrefix(TokenType op, const Constant& value, std::string& error)
+	{
+		if (!value.isKnown() || value.type == Constant::Type::STRING) { return Constant(); }
+
+		switch (op)
+		{
+			case TokenType::MINUS: return checkedInt(-value.intValue, error);
+			case TokenType::PLUS: return Constant::fromInt(value.intValue);
+			case TokenType::NOT: return Constant::fromBool(value.intValue == 0);
+
+			default:
+				return Constant();
+		}
+	}
+
+	bool isAssignmentOperator(TokenType op)
+	{
+		switch (op)
+		{
+			case TokenType::PLUS_EQUALS:
+			case TokenType::MINUS_EQUALS:
+			case TokenType::MULTIPLY_EQUALS:
+			case TokenType::DIVIDE_EQUALS:
+				return true;
+
+			default:
+				return false;
+		}
+	}
+
+	// C++ precedence of the binary operators (higher binds tighter)
+	static int precedence(TokenType op)
+	{
+		switch (op)
+		{
+			case TokenType::MULTIPLY:
+			case TokenType::DIVIDE:
+			case TokenType::MODULO:
+				return 13;
+
+			case TokenType::PLUS:
+			case TokenType::MINUS:
+				return 12;
+
+			case TokenType::LESS_THAN:
+			case TokenType::LESS_THAN_EQUALS:
+			case TokenType::GREATER_THAN:
+			case TokenType::GREATER_THAN_EQUALS:
+				return 10;
+
+			case TokenType::EQUALS:
+			case TokenType::NOT_EQUALS:
+				return 9;
+
+			case TokenType::AND:
+				return 5;
+
+			case TokenType::OR:
+				return 4;
+
+			// Assignments (and anything unknown) bind the loosest
+			default:
+				return 2;
+		}
+	}
+
+	// Precedence of a whole tree so it can be compared with the operator it is an operand of
+	static constexpr int PREFIX_PRECEDENCE = 15;
+	static constexpr int POSTFIX_PRECEDENCE = 16;
+	static constexpr int LEAF_PRECEDENCE = 17;
+
+	static int treePrecedence(const Expression& tree)
+	{
+		switch (tree.kind)
+		{
+			case Expression::Kind::BINARY: return precedence(tree.op);
+			case Expression::Kind::PREFIX: return PREFIX_PRECEDENCE;
+			case Expression::Kind::POSTFIX: return POSTFIX_PRECEDENCE;
+			default: return LEAF_PRECEDENCE;
+		}
+	}
+
+	void Expression::makeLeaf(std::unique_ptr<LX::Parser::ASTNode> node)
+	{
+		kind = Kind::LEAF;
+		leaf = std::move(node);
+		op = TokenType::UNDEFINED;
+		lhs = nullptr;
+		rhs = nullptr;
+	}
+
+	void ExpressionView::makeLeaf(const LX::Parser::ASTNode* node)
+	{
+		kind = Expression::Kind::LEAF;
+		leaf = node;
+		op = TokenType::UNDEFINED;
+		lhs = nullptr;
+		rhs = nullptr;
+	}
+
+	// An expression written out in the order the translator writes it
+	// Operand is the type of the leaves (owned by an Expression or pointed to by an ExpressionView)
+	template<typename Operand>
+	struct FlatItem
+	{
+		enum class Kind : char
+		{
+			OPERAND,
+			BINARY,
+			PREFIX,
+			POSTFIX
+		};
+
+		Kind kind;
+		TokenType op;
+		Operand operand;
+	};
+
+	typedef FlatItem<std::unique_ptr<LX::Parser::ASTNode>> OwnedItem;
+	typedef FlatItem<const LX::Parser::ASTNode*> ViewItem;
+
+	static bool isComplete(const LX::Parser::ASTNode* node)
+	{
+		if (node == nullptr) { return false; }
+
+		switch (node->type)
+		{
+			case LX::Parser::ASTNode::NodeType::OPERATION:
+			{
+				const LX::Parser::Operation* operation = static_cast<const LX::Parser::Operation*>(node);
+				return isComplete(operation->lhs.get()) && isComplete(operation->rhs.get());
+			}
+
+			case LX::Parser::ASTNode::NodeType::UNARY_OPERATION:
+				return isComplete(static_cast<const LX::Parser::UnaryOperation*>(node)->val.get());
+
+			default:
+				return true;
+		}
+	}
+
+	static void flatten(std::unique_ptr<LX::Parser::ASTNode> node, std::vector<OwnedItem>& items)
+	{
+		switch (node->type)
+		{
+			case LX::Parser::ASTNode::NodeType::OPERATION:
+			{
+				LX::Parser::Operation* operation = static_cast<LX::Parser::Operation*>(node.get());
+
+				flatten(std::move(operation->lhs), items);
+				items.push_back({ OwnedItem::Kind::BINARY, operation->op, nullptr });
+				flatten(std::move(operation->rhs), items);
+
+				return;
+			}
+
+			case LX::Parser::ASTNode::NodeType::UNARY_OPERATION:
+			{
+				LX::Parser::UnaryOperation* unary = static_cast<LX::Parser::UnaryOperation*>(node.get());
+
+				if (unary->side == LX::Parser::UnaryOperation::Sided::LEFT)
+				{
+					items.push_back({ OwnedItem::Kind::PREFIX, unary->op, nullptr });
+					flatten(std::move(unary->val), items);
+				}
+
+				else
+				{
+					flatten(std::move(unary->val), items);
+					items.push_back({ OwnedItem::Kind::POSTFIX, unary->op, nullptr });
+				}
+
+				return;
+			}
+
+			default:
+				items.push_back({ OwnedItem::Kind::OPERAND, TokenType::UNDEFINED, std::move(node) });
+				return;
+		}
+	}
+
+	// Same as above without moving the nodes out of the AST
+	static void flatten(const LX::Parser::ASTNode* node, std::vector<ViewItem>& items)
+	{
+		switch (node->type)
+		{
+			case LX::Parser::ASTNode::NodeType::OPERATION:
+			{
+				const LX::Parser::Operation* operation = static_cast<const LX::Parser::Operation*>(node);
+
+				flatten(operation->lhs.get(), items);
+				items.push_back({ ViewItem::Kind::BINARY, operation->op, nullptr });
+				flatten(operation->rhs.get(), items);
+
+				return;
+			}
+
+			case LX::Parser::ASTNode::NodeType::UNARY_OPERATION:
+			{
+				const LX::Parser::UnaryOperation* unary = static_cast<const LX::Parser::UnaryOperation*>(node);
+
+				if (unary->side == LX::Parser::UnaryOperation::Sided::LEFT)
+				{
+					items.push_back({ ViewItem::Kind::PREFIX, unary->op, nullptr });
+					flatten(unary->val.get(), items);
+				}
+
+				else
+				{
+					flatten(unary->val.get(), items);
+					items.push_back({ ViewItem::Kind::POSTFIX, unary->op, nullptr });
+				}
+
+				return;
+			}
+
+			default:
+				items.push_back({ ViewItem::Kind::OPERAND, TokenType::UNDEFINED, node });
+				return;
+		}
+	}
+
+	// Precedence climbing parser over the flattened expression
+	// Tree is Expression or ExpressionView depending on the type of the items
+	template<typename Tree, typename Item>
+	class TreeBuilder
+	{
+		private:
+			std::vector<Item>& items;
+			size_t index = 0;
+
+		public:
+			TreeBuilder(std::vector<Item>& items) : items(items) {}
+
+			std::unique_ptr<Tree> parseUnary()
+			{
+				Item& item = items[index++];
+				std::unique_ptr<Tree> out = std::make_unique<Tree>();
+
+				if (item.kind == Item::Kind::PREFIX)
+				{
+					out->kind = Expression::Kind::PREFIX;
+					out->op = item.op;
+					out->lhs = parseUnary();
+				}
+
+				// Postfix operators bind tighter than prefix ones so the operand has already taken them
+				else
+				{
+					out->makeLeaf(std::move(item.operand));
+
+					while (index < items.size() && items[index].kind == Item::Kind::POSTFIX)
+					{
+						std::unique_ptr<Tree> postfix = std::make_unique<Tree>();
+						postfix->kind = Expression::Kind::POSTFIX;
+						postfix->op = items[index++].op;
+						postfix->lhs = std::move(out);
+
+						out = std::move(postfix);
+					}
+				}
+
+				return out;
+			}
+
+			std::unique_ptr<Tree> parseBinary(int minPrecedence)
+			{
+				std::unique_ptr<Tree> lhs = parseUnary();
+
+				while (index < items.size() && items[index].kind == Item::Kind::BINARY && precedence(items[index].op) >= minPrecedence)
+				{
+					TokenType op = items[index++].op;
+
+					// Assignments are right associative and everything else is left associative
+					int nextPrecedence = isAssignmentOperator(op) ? precedence(op) : precedence(op) + 1;
+
+					std::unique_ptr<Tree> binary = std::make_unique<Tree>();
+					binary->kind = Expression::Kind::BINARY;
+					binary->op = op;
+					binary->lhs = std::move(lhs);
+					binary->rhs = parseBinary(nextPrecedence);
+
+					lhs = std::move(binary);
+				}
+
+				return lhs;
+			}
+	};
+
+	std::unique_ptr<Expression> toTree(std::unique_ptr<LX::Parser::ASTNode>& node)
+	{
+		if (!isComplete(node.get())) { return nullptr; }
+
+		std::vector<OwnedItem> items;
+		flatten(std::move(node), items);
+
+		TreeBuilder<Expression, OwnedItem> builder(items);
+		return builder.parseBinary(0);
+	}
+
+	std::unique_ptr<ExpressionView> viewTree(const LX::Parser::ASTNode* node)
+	{
+		if (!isComplete(node)) { return nullptr; }
+
+		std::vector<ViewItem> items;
+		flatten(node, items);
+
+		TreeBuilder<ExpressionView, ViewItem> builder(items);
+		return builder.parseBinary(0);
+	}
+
+	static std::unique_ptr<LX::Parser::ASTNode> bracket(std::unique_ptr<LX::Parser::ASTNode> node, bool needed)
+	{
+		if (!needed) { return node; }
+
+		std::unique_ptr<LX::Parser::BracketedExpression> out = std::make_unique<LX::Parser::BracketedExpression>();
+		out->expr = std::move(node);
+		return out;
+	}
+
+	std::unique_ptr<LX::Parser::ASTNode> fromTree(std::unique_ptr<Expression> tree)
+	{
+		switch (tree->kind)
+		{
+			case Expression::Kind::PREFIX:
+			case Expression::Kind::POSTFIX:
+			{
+				bool isPrefix = tree->kind == Expression::Kind::PREFIX;
+				bool needsBracket = treePrecedence(*tree->lhs) < (isPrefix ? PREFIX_PRECEDENCE : POSTFIX_PRECEDENCE);
+
+				std::unique_ptr<LX::Parser::UnaryOperation> out = std::make_unique<LX::Parser::UnaryOperation>();
+				out->op = tree->op;
+				out->side = isPrefix ? LX::Parser::UnaryOperation::Sided::LEFT : LX::Parser::UnaryOperation::Sided::RIGHT;
+				out->val = bracket(fromTree(std::move(tree->lhs)), needsBracket);
+
+				return out;
+			}
+
+			case Expression::Kind::BINARY:
+			{
+				int opPrecedence = precedence(tree->op);
+				bool rightAssociative = isAssignmentOperator(tree->op);
+
+				int lhsPrecedence = treePrecedence(*tree->lhs);
+				int rhsPrecedence = treePrecedence(*tree->rhs);
+
+				// Operands that would otherwise be read as part of a different operation are put in brackets
+				bool lhsBracket = lhsPrecedence < opPrecedence || (rightAssociative && lhsPrecedence == opPrecedence);
+				bool rhsBracket = rhsPrecedence < opPrecedence || (!rightAssociative && rhsPrecedence == opPrecedence);
+
+				std::unique_ptr<LX::Parser::Operation> out = std::make_unique<LX::Parser::Operation>();
+				out->op = tree->op;
+				out->lhs = bracket(fromTree(std::move(tree->lhs)), lhsBracket);
+				out->rhs = bracket(fromTree(std::move(tree->rhs)), rhsBracket);
+
+				return out;
+			}
+
+			default:
+				return std::move(tree->leaf);
+		}
+	}
+}
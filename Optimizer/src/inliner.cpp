@@ -0,0 +1,624 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <inliner.h>
+
+#include <common.h>
+
+#include <ast-walk.h>
+#include <call-graph.h>
+#include <expression.h>
+#include <static-constants.h>
+
+namespace LX::Optimizer
+{
+	using LX::Lexer::TokenType;
+
+	// Number of nodes in an expression (used as the size of a function)
+	static size_t countNodes(const LX::Parser::ASTNode* node)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return 0; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::OPERATION:
+				return 1 + countNodes(static_cast<const Operation*>(node)->lhs.get()) + countNodes(static_cast<const Operation*>(node)->rhs.get());
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+				return 1 + countNodes(static_cast<const UnaryOperation*>(node)->val.get());
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				return countNodes(static_cast<const BracketedExpression*>(node)->expr.get());
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				size_t count = 1;
+
+				for (const std::unique_ptr<ASTNode>& arg : static_cast<const FunctionCall*>(node)->args)
+				{
+					count += countNodes(arg.get());
+				}
+
+				return count;
+			}
+
+			default:
+				return 1;
+		}
+	}
+
+	// Number of times a parameter is used in an expression
+	static size_t countUses(const LX::Parser::ASTNode* node, const std::string& name)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return 0; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+				return static_cast<const Identifier*>(node)->name == name ? 1 : 0;
+
+			case ASTNode::NodeType::OPERATION:
+				return countUses(static_cast<const Operation*>(node)->lhs.get(), name) + countUses(static_cast<const Operation*>(node)->rhs.get(), name);
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+				return countUses(static_cast<const UnaryOperation*>(node)->val.get(), name);
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				return countUses(static_cast<const BracketedExpression*>(node)->expr.get(), name);
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				size_t uses = 0;
+
+				for (const std::unique_ptr<ASTNode>& arg : static_cast<const FunctionCall*>(node)->args)
+				{
+					uses += countUses(arg.get(), name);
+				}
+
+				return uses;
+			}
+
+			default:
+				return 0;
+		}
+	}
+
+	// Returns why the returned expression of a function cannot be copied into its callers (empty if it can be)
+	static std::string checkBody(const LX::Parser::ASTNode* node, const std::unordered_set<std::string>& params)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return "has an incomplete expression"; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				const std::string& name = static_cast<const Identifier*>(node)->name;
+
+				return isLiteral(node) || params.count(name) != 0 ? "" : "uses a name that is not a parameter";
+			}
+
+			case ASTNode::NodeType::STRING_LITERAL:
+				return "";
+
+			case ASTNode::NodeType::OPERATION:
+			{
+				const Operation* operation = static_cast<const Operation*>(node);
+
+				if (isAssignmentOperator(operation->op)) { return "changes a parameter"; }
+
+				std::string reason = checkBody(operation->lhs.get(), params);
+				return reason.empty() ? checkBody(operation->rhs.get(), params) : reason;
+			}
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				const UnaryOperation* unary = static_cast<const UnaryOperation*>(node);
+
+				if (unary->op == TokenType::INCREMENT || unary->op == TokenType::DECREMENT) { return "changes a parameter"; }
+
+				return checkBody(unary->val.get(), params);
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				return checkBody(static_cast<const BracketedExpression*>(node)->expr.get(), params);
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+				for (const std::unique_ptr<ASTNode>& arg : static_cast<const FunctionCall*>(node)->args)
+				{
+					if (std::string reason = checkBody(arg.get(), params); reason.empty() == false) { return reason; }
+				}
+
+				return "";
+
+			default:
+				return "has an expression that cannot be inlined";
+		}
+	}
+
+	// Returns why calls of the function cannot be inlined (empty if they can be)
+	static std::string checkFunction(const LX::Parser::FunctionDeclaration& func, size_t threshold)
+	{
+		using namespace LX::Parser;
+
+		if (func.returnTypes.size() != 1) { return "does not return a single value"; }
+
+		const std::string& returnType = func.returnTypes[0].name;
+
+		if (returnType != "int" && returnType != "std::string") { return "returns a type that is not int or string"; }
+
+		if (func.body.size() != 1 || func.body[0] == nullptr || func.body[0]->type != ASTNode::NodeType::RETURN_STATEMENT)
+		{
+			return "body is not a single return statement";
+		}
+
+		const ASTNode* expr = static_cast<const ReturnStatement*>(func.body[0].get())->expr.get();
+
+		std::unordered_set<std::string> params;
+		std::unordered_set<std::string> stringParams;
+
+		for (const std::unique_ptr<ASTNode>& arg : func.args)
+		{
+			const VariableDeclaration* param = static_cast<const VariableDeclaration*>(arg.get());
+
+			if ((param->varType.name != "int" && param->varType.name != "string") || param->isPointer())
+			{
+				return "has a parameter that is not an int or string";
+			}
+
+			params.insert(param->name.name);
+
+			if (param->varType.name == "string") { stringParams.insert(param->name.name); }
+		}
+
+		// A string literal is not a std::string in C++ so only strings that were passed in can be returned
+		if (returnType == "std::string" && (expr == nullptr || expr->type != ASTNode::NodeType::IDENTIFIER || stringParams.count(static_cast<const Identifier*>(expr)->name) == 0))
+		{
+			return "returns a string that is not a parameter";
+		}
+
+		if (std::string reason = checkBody(expr, params); reason.empty() == false) { return reason; }
+
+		size_t size = countNodes(expr);
+
+		if (size > threshold)
+		{
+			return "too large, " + std::to_string(size) + " nodes with a threshold of " + std::to_string(threshold);
+		}
+
+		return "";
+	}
+
+	Inliner::Inliner(const std::vector<LX::Parser::FileAST*>& files, size_t threshold) : threshold(threshold)
+	{
+		CallGraph graph;
+		graph.build(files);
+
+		std::unordered_map<std::string, size_t> overloads;
+
+		for (LX::Parser::FileAST* file : files)
+		{
+			for (const LX::Parser::FunctionDeclaration& func : file->functions)
+			{
+				callees[func.name.name].func = &func;
+				overloads[func.name.name]++;
+			}
+		}
+
+		for (auto& [name, callee] : callees)
+		{
+			if (overloads[name] != 1) { callee.reason = "overloaded"; }
+			else if (graph.isRecursive(name)) { callee.reason = "recursive"; }
+			else { callee.reason = checkFunction(*callee.func, threshold); }
+		}
+	}
+
+	std::string Inliner::checkArgument(const LX::Parser::ASTNode* arg, const std::string& paramType) const
+	{
+		using namespace LX::Parser;
+
+		if (arg == nullptr) { return "is incomplete"; }
+
+		// A string literal would stop being a std::string
+		if (paramType == "string")
+		{
+			if (arg->type != ASTNode::NodeType::IDENTIFIER) { return "is not a string variable"; }
+
+			auto it = variableTypes.find(static_cast<const Identifier*>(arg)->name);
+
+			return it != variableTypes.end() && it->second == "string" ? "" : "is not a string variable";
+		}
+
+		switch (arg->type)
+		{
+			// Other types would be converted to an int by the call
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				Constant value = literalValue(arg);
+
+				if (value.isKnown()) { return value.type == Constant::Type::STRING ? "is not an int" : ""; }
+
+				auto it = variableTypes.find(static_cast<const Identifier*>(arg)->name);
+
+				return it != variableTypes.end() && it->second == "int" ? "" : "is not an int";
+			}
+
+			case ASTNode::NodeType::OPERATION:
+			{
+				const Operation* operation = static_cast<const Operation*>(arg);
+
+				if (isAssignmentOperator(operation->op)) { return "changes a variable"; }
+
+				std::string reason = checkArgument(operation->lhs.get(), paramType);
+				return reason.empty() ? checkArgument(operation->rhs.get(), paramType) : reason;
+			}
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				const UnaryOperation* unary = static_cast<const UnaryOperation*>(arg);
+
+				if (unary->op == TokenType::INCREMENT || unary->op == TokenType::DECREMENT) { return "changes a variable"; }
+
+				return checkArgument(unary->val.get(), paramType);
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				return checkArgument(static_cast<const BracketedExpression*>(arg)->expr.get(), paramType);
+
+			// Calls could be run in a different order once they are inlined
+			case ASTNode::NodeType::FUNCTION_CALL:
+				return "has a call";
+
+			default:
+				return "is not an int";
+		}
+	}
+
+	std::string Inliner::checkCall(const LX::Parser::FunctionCall* call, const Callee& callee) const
+	{
+		using namespace LX::Parser;
+
+		if (callee.reason.empty() == false) { return callee.reason; }
+
+		const FunctionDeclaration& func = *callee.func;
+
+		if (call->args.size() != func.args.size()) { return "wrong number of arguments"; }
+
+		const ASTNode* expr = static_cast<const ReturnStatement*>(func.body[0].get())->expr.get();
+
+		for (size_t i = 0; i < call->args.size(); i++)
+		{
+			const VariableDeclaration* param = static_cast<const VariableDeclaration*>(func.args[i].get());
+			const ASTNode* arg = call->args[i].get();
+
+			std::string reason = checkArgument(arg, param->varType.name);
+
+			if (reason.empty() == false) { return "argument " + std::to_string(i + 1) + " " + reason; }
+
+			// Copying anything other than a variable or a literal would run it more than once
+			if (arg->type != ASTNode::NodeType::IDENTIFIER && countUses(expr, param->name.name) > 1)
+			{
+				return "argument " + std::to_string(i + 1) + " would be calculated more than once";
+			}
+		}
+
+		return "";
+	}
+
+	// Copies an expression with the parameters replaced by the arguments
+	static std::unique_ptr<LX::Parser::ASTNode> substitute(const LX::Parser::ASTNode* node, const std::unordered_map<std::string, const LX::Parser::ASTNode*>& args)
+	{
+		using namespace LX::Parser;
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				const std::string& name = static_cast<const Identifier*>(node)->name;
+
+				if (auto it = args.find(name); it != args.end())
+				{
+					// The translator writes expressions out flat so an argument that is an operation needs brackets
+					std::unique_ptr<ASTNode> arg = substitute(it->second, {});
+
+					if (arg->type != ASTNode::NodeType::OPERATION && arg->type != ASTNode::NodeType::UNARY_OPERATION) { return arg; }
+
+					std::unique_ptr<BracketedExpression> brackets = std::make_unique<BracketedExpression>();
+					brackets->expr = std::move(arg);
+					return brackets;
+				}
+
+				return std::make_unique<Identifier>(name);
+			}
+
+			case ASTNode::NodeType::STRING_LITERAL:
+				return std::make_unique<StringLiteral>(static_cast<const StringLiteral*>(node)->value);
+
+			case ASTNode::NodeType::OPERATION:
+			{
+				const Operation* operation = static_cast<const Operation*>(node);
+
+				std::unique_ptr<Operation> out = std::make_unique<Operation>();
+				out->op = operation->op;
+				out->lhs = substitute(operation->lhs.get(), args);
+				out->rhs = substitute(operation->rhs.get(), args);
+				return out;
+			}
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				const UnaryOperation* unary = static_cast<const UnaryOperation*>(node);
+
+				std::unique_ptr<UnaryOperation> out = std::make_unique<UnaryOperation>();
+				out->op = unary->op;
+				out->side = unary->side;
+				out->val = substitute(unary->val.get(), args);
+				return out;
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+			{
+				std::unique_ptr<BracketedExpression> out = std::make_unique<BracketedExpression>();
+				out->expr = substitute(static_cast<const BracketedExpression*>(node)->expr.get(), args);
+				return out;
+			}
+
+			// Checked by checkBody so this can only be a function call
+			default:
+			{
+				const FunctionCall* call = static_cast<const FunctionCall*>(node);
+
+				std::unique_ptr<FunctionCall> out = std::make_unique<FunctionCall>();
+				out->setFlags(call->getFlags());
+				out->funcName.name = call->funcName.name;
+
+				for (const std::unique_ptr<ASTNode>& arg : call->args)
+				{
+					out->args.push_back(substitute(arg.get(), args));
+				}
+
+				return out;
+			}
+		}
+	}
+
+	std::vector<std::string> Inliner::inlineCalls(LX::Parser::FunctionDeclaration& func, std::vector<std::string>& out)
+	{
+		using namespace LX::Parser;
+
+		functionName = &func.name.name;
+		report = &out;
+		inlined.clear();
+		variableTypes.clear();
+
+		// Names that are declared more than once with different types are never given a type
+		auto addVariable = [&](const VariableDeclaration* var)
+		{
+			std::string type = var->isPointer() ? "" : (var->isUnsigned() ? "unsigned " : "") + var->varType.name;
+
+			if (auto [it, added] = variableTypes.emplace(var->name.name, type); added == false && it->second != type)
+			{
+				it->second.clear();
+			}
+		};
+
+		for (const std::unique_ptr<ASTNode>& arg : func.args)
+		{
+			addVariable(static_cast<const VariableDeclaration*>(arg.get()));
+		}
+
+		walk(func, [&](ASTNode* node)
+		{
+			if (node->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+			{
+				addVariable(static_cast<VariableDeclaration*>(node));
+			}
+		});
+
+		inlineBlock(func.body);
+
+		return inlined;
+	}
+
+	void Inliner::inlineBlock(LX::Parser::AST& body)
+	{
+		for (std::unique_ptr<LX::Parser::ASTNode>& statement : body)
+		{
+			inlineStatement(statement);
+		}
+	}
+
+	void Inliner::inlineStatement(std::unique_ptr<LX::Parser::ASTNode>& node)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+			{
+				VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(node.get());
+
+				if (varDecl->val != nullptr) { inlineExpression(varDecl->val->val); }
+				return;
+			}
+
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+				inlineExpression(static_cast<DestructuringDeclaration*>(node.get())->val);
+				return;
+
+			case ASTNode::NodeType::ASSIGNMENT:
+				inlineExpression(static_cast<Assignment*>(node.get())->val);
+				return;
+
+			case ASTNode::NodeType::IF_STATEMENT:
+			{
+				IfStatement* ifStatement = static_cast<IfStatement*>(node.get());
+
+				while (ifStatement != nullptr)
+				{
+					inlineExpression(ifStatement->condition);
+					inlineBlock(ifStatement->body);
+
+					ifStatement = ifStatement->next.get();
+				}
+
+				return;
+			}
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(node.get());
+
+				inlineStatement(loopStatement->init);
+				inlineExpression(loopStatement->condition);
+				inlineBlock(loopStatement->body);
+				inlineStatement(loopStatement->step);
+
+				return;
+			}
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+				inlineExpression(static_cast<ReturnStatement*>(node.get())->expr);
+				return;
+
+			// A call on its own is only run for what it does so is left as a call (only its arguments are inlined)
+			case ASTNode::NodeType::FUNCTION_CALL:
+				for (std::unique_ptr<ASTNode>& arg : static_cast<FunctionCall*>(node.get())->args)
+				{
+					inlineExpression(arg);
+				}
+
+				return;
+
+			default:
+				inlineExpression(node);
+				return;
+		}
+	}
+
+	void Inliner::inlineExpression(std::unique_ptr<LX::Parser::ASTNode>& node)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::OPERATION:
+				inlineExpression(static_cast<Operation*>(node.get())->lhs);
+				inlineExpression(static_cast<Operation*>(node.get())->rhs);
+				return;
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+				inlineExpression(static_cast<UnaryOperation*>(node.get())->val);
+				return;
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				inlineExpression(static_cast<BracketedExpression*>(node.get())->expr);
+				return;
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+				for (std::unique_ptr<ASTNode>& value : static_cast<TupleExpression*>(node.get())->values)
+				{
+					inlineExpression(value);
+				}
+
+				return;
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				FunctionCall* call = static_cast<FunctionCall*>(node.get());
+
+				// Arguments are inlined first as a call in an argument stops the call from being inlined
+				for (std::unique_ptr<ASTNode>& arg : call->args)
+				{
+					inlineExpression(arg);
+				}
+
+				// Calls to functions outside of the project (such as core functions) are not part of the report
+				auto it = callees.find(call->funcName.name);
+
+				if (it == callees.end()) { return; }
+
+				std::string reason = checkCall(call, it->second);
+
+				if (reason.empty() == false)
+				{
+					report->push_back(*functionName + ": " + call->funcName.name + " not inlined (" + reason + ")");
+					return;
+				}
+
+				report->push_back(*functionName + ": " + call->funcName.name + " inlined");
+				inlined.push_back(call->funcName.name);
+
+				const FunctionDeclaration& func = *it->second.func;
+				std::unordered_map<std::string, const ASTNode*> args;
+
+				for (size_t i = 0; i < call->args.size(); i++)
+				{
+					args[static_cast<const VariableDeclaration*>(func.args[i].get())->name.name] = call->args[i].get();
+				}
+
+				std::unique_ptr<ASTNode> body = substitute(static_cast<const ReturnStatement*>(func.body[0].get())->expr.get(), args);
+
+				// The call could be an operand of an operation so the body is kept together with brackets
+				if (body->type == ASTNode::NodeType::OPERATION || body->type == ASTNode::NodeType::UNARY_OPERATION)
+				{
+					std::unique_ptr<BracketedExpression> brackets = std::make_unique<BracketedExpression>();
+					brackets->expr = std::move(body);
+					body = std::move(brackets);
+				}
+
+				node = std::move(body);
+
+				// Calls made by the inlined function are inlined as well (this ends as inlined functions are never recursive)
+				inlineExpression(node);
+				return;
+			}
+
+			default:
+				return;
+		}
+	}
+}
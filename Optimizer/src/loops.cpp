@@ -0,0 +1,875 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <loops.h>
+
+#include <common.h>
+
+#include <ast-walk.h>
+#include <expression.h>
+#include <reference-params.h>
+
+namespace LX::Optimizer
+{
+	using LX::Lexer::TokenType;
+
+	// Most nodes the copies of an unrolled body can have in total
+	static constexpr size_t UNROLLED_NODE_LIMIT = 256;
+
+	// Returns true if the node is the variable with the name
+	static bool isVariable(const LX::Parser::ASTNode* node, const std::string& name)
+	{
+		return node != nullptr && node->type == LX::Parser::ASTNode::NodeType::IDENTIFIER && static_cast<const LX::Parser::Identifier*>(node)->name == name;
+	}
+
+	// Returns true if the node is an int literal (and sets the value)
+	static bool intLiteral(const LX::Parser::ASTNode* node, long long& value)
+	{
+		Constant constant = literalValue(node);
+
+		if (constant.type != Constant::Type::INT) { return false; }
+
+		value = constant.intValue;
+		return true;
+	}
+
+	// -- Unrolling -- //
+
+	// Finds the value of the counter on each run of a for loop
+	// Returns false if the loop does not count between two literals or runs more than limit times
+	static bool countedValues(const LX::Parser::LoopStatement* loop, size_t limit, std::string& counter, std::vector<long long>& values)
+	{
+		using namespace LX::Parser;
+
+		if (loop->loopType != LoopStatement::LoopType::FOR || loop->init == nullptr || loop->init->type != ASTNode::NodeType::VARIABLE_DECLARATION) { return false; }
+
+		// The counter has to be a plain int that starts at a literal
+		const VariableDeclaration* var = static_cast<const VariableDeclaration*>(loop->init.get());
+
+		if (var->varType.name != "int" || var->isUnsigned() || var->isReference() || var->isPointer() || var->isStatic() || var->val == nullptr) { return false; }
+
+		long long value = 0;
+		if (intLiteral(var->val->val.get(), value) == false) { return false; }
+
+		counter = var->name.name;
+
+		// The condition has to compare the counter to a literal (such as i < 4)
+		const ASTNode* condition = loop->condition.get();
+
+		if (condition == nullptr || condition->type != ASTNode::NodeType::OPERATION) { return false; }
+
+		const Operation* comparison = static_cast<const Operation*>(condition);
+
+		long long bound = 0;
+		if (isVariable(comparison->lhs.get(), counter) == false || intLiteral(comparison->rhs.get(), bound) == false) { return false; }
+
+		switch (comparison->op)
+		{
+			case TokenType::LESS_THAN:
+			case TokenType::LESS_THAN_EQUALS:
+			case TokenType::GREATER_THAN:
+			case TokenType::GREATER_THAN_EQUALS:
+			case TokenType::NOT_EQUALS:
+				break;
+
+			default:
+				return false;
+		}
+
+		// The step has to add a literal to the counter (i++, i--, i += 2, i -= 2 or i = i + 2)
+		const ASTNode* step = loop->step.get();
+		long long change = 0;
+
+		if (step == nullptr) { return false; }
+
+		if (step->type == ASTNode::NodeType::UNARY_OPERATION)
+		{
+			const UnaryOperation* unary = static_cast<const UnaryOperation*>(step);
+
+			if (isVariable(unary->val.get(), counter) == false) { return false; }
+
+			if (unary->op == TokenType::INCREMENT) { change = 1; }
+			else if (unary->op == TokenType::DECREMENT) { change = -1; }
+		}
+
+		else if (step->type == ASTNode::NodeType::OPERATION)
+		{
+			const Operation* operation = static_cast<const Operation*>(step);
+
+			if (isVariable(operation->lhs.get(), counter) == false || intLiteral(operation->rhs.get(), change) == false) { return false; }
+
+			if (operation->op == TokenType::MINUS_EQUALS) { change = -change; }
+			else if (operation->op != TokenType::PLUS_EQUALS) { return false; }
+		}
+
+		else if (step->type == ASTNode::NodeType::ASSIGNMENT)
+		{
+			const Assignment* assignment = static_cast<const Assignment*>(step);
+			const ASTNode* value = assignment->val.get();
+
+			if (assignment->name.name != counter || value == nullptr || value->type != ASTNode::NodeType::OPERATION) { return false; }
+
+			const Operation* operation = static_cast<const Operation*>(value);
+
+			if (isVariable(operation->lhs.get(), counter) == false || intLiteral(operation->rhs.get(), change) == false) { return false; }
+
+			if (operation->op == TokenType::MINUS) { change = -change; }
+			else if (operation->op != TokenType::PLUS) { return false; }
+		}
+
+		if (change == 0) { return false; }
+
+		// Runs the loop the same way the C++ code would (overflowing the counter is an error so those loops are left alone)
+		while (true)
+		{
+			std::string error;
+			Constant runs = evaluateBinary(comparison->op, Constant::fromInt(value), Constant::fromInt(bound), error);
+
+			if (runs.isKnown() == false) { return false; }
+			if (runs.intValue == 0) { return true; }
+
+			if (values.size() == limit) { return false; }
+			values.push_back(value);
+
+			Constant next = evaluateBinary(TokenType::PLUS, Constant::fromInt(value), Constant::fromInt(change), error);
+
+			if (next.isKnown() == false) { return false; }
+			value = next.intValue;
+		}
+	}
+
+	// Returns true if a statement of the block (or an if statement within it) is a break or continue
+	// Jumps within a nested loop belong to that loop
+	static bool hasJump(const LX::Parser::AST& body)
+	{
+		using namespace LX::Parser;
+
+		for (const std::unique_ptr<ASTNode>& statement : body)
+		{
+			if (statement == nullptr) { continue; }
+
+			if (statement->type == ASTNode::NodeType::JUMP_STATEMENT) { return true; }
+
+			if (statement->type == ASTNode::NodeType::IF_STATEMENT)
+			{
+				for (const IfStatement* branch = static_cast<const IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+				{
+					if (hasJump(branch->body)) { return true; }
+				}
+			}
+		}
+
+		return false;
+	}
+
+	// Returns true if the body can be copied once for each run of the loop
+	static bool canUnroll(LX::Parser::AST& body, const std::string& counter, const std::unordered_set<std::string>& referenceFunctions)
+	{
+		using namespace LX::Parser;
+
+		if (hasJump(body)) { return false; }
+
+		std::unordered_set<std::string> written;
+		bool declaresCounter = false;
+
+		for (std::unique_ptr<ASTNode>& statement : body)
+		{
+			// Nodes can be null after a parser error
+			if (statement == nullptr) { return false; }
+
+			// The copies share a scope so a variable of the body would be declared more than once
+			if (statement->type == ASTNode::NodeType::VARIABLE_DECLARATION || statement->type == ASTNode::NodeType::DESTRUCTURING_DECLARATION) { return false; }
+
+			walk(statement.get(), [&](ASTNode* node)
+			{
+				addWrittenVariable(node, referenceFunctions, written);
+
+				if (node->type == ASTNode::NodeType::VARIABLE_DECLARATION && static_cast<VariableDeclaration*>(node)->name.name == counter) { declaresCounter = true; }
+			});
+		}
+
+		return declaresCounter == false && written.find(counter) == written.end();
+	}
+
+	// Copies a node with every read of the counter replaced with its value
+	static std::unique_ptr<LX::Parser::ASTNode> copyWithValue(const LX::Parser::ASTNode* node, const std::string& counter, long long value)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return nullptr; }
+
+		auto copyBody = [&](const AST& from, AST& to)
+		{
+			for (const std::unique_ptr<ASTNode>& statement : from)
+			{
+				to.push_back(copyWithValue(statement.get(), counter, value));
+			}
+		};
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				const std::string& name = static_cast<const Identifier*>(node)->name;
+
+				if (name != counter) { return std::make_unique<Identifier>(name); }
+
+				// The translator writes expressions out flat so a negative value needs brackets (x - -1 could become x--1)
+				std::unique_ptr<ASTNode> literal = makeLiteral(Constant::fromInt(value));
+
+				if (value >= 0) { return literal; }
+
+				std::unique_ptr<BracketedExpression> brackets = std::make_unique<BracketedExpression>();
+				brackets->expr = std::move(literal);
+				return brackets;
+			}
+
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+			{
+				const VariableDeclaration* varDecl = static_cast<const VariableDeclaration*>(node);
+
+				std::unique_ptr<VariableDeclaration> out = std::make_unique<VariableDeclaration>();
+				out->setFlags(varDecl->getFlags());
+				out->varType.name = varDecl->varType.name;
+				out->name.name = varDecl->name.name;
+
+				if (varDecl->val != nullptr)
+				{
+					out->val = std::make_unique<Assignment>();
+					out->val->val = copyWithValue(varDecl->val->val.get(), counter, value);
+				}
+
+				return out;
+			}
+
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+			{
+				const DestructuringDeclaration* destructuring = static_cast<const DestructuringDeclaration*>(node);
+
+				std::unique_ptr<DestructuringDeclaration> out = std::make_unique<DestructuringDeclaration>();
+
+				for (const std::unique_ptr<VariableDeclaration>& var : destructuring->vars)
+				{
+					out->vars.emplace_back(static_cast<VariableDeclaration*>(copyWithValue(var.get(), counter, value).release()));
+				}
+
+				out->val = copyWithValue(destructuring->val.get(), counter, value);
+				return out;
+			}
+
+			case ASTNode::NodeType::ASSIGNMENT:
+			{
+				const Assignment* assignment = static_cast<const Assignment*>(node);
+
+				std::unique_ptr<Assignment> out = std::make_unique<Assignment>();
+				out->name.name = assignment->name.name;
+				out->val = copyWithValue(assignment->val.get(), counter, value);
+				return out;
+			}
+
+			case ASTNode::NodeType::OPERATION:
+			{
+				const Operation* operation = static_cast<const Operation*>(node);
+
+				std::unique_ptr<Operation> out = std::make_unique<Operation>();
+				out->op = operation->op;
+				out->lhs = copyWithValue(operation->lhs.get(), counter, value);
+				out->rhs = copyWithValue(operation->rhs.get(), counter, value);
+				return out;
+			}
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				const UnaryOperation* unary = static_cast<const UnaryOperation*>(node);
+
+				std::unique_ptr<UnaryOperation> out = std::make_unique<UnaryOperation>();
+				out->op = unary->op;
+				out->side = unary->side;
+				out->val = copyWithValue(unary->val.get(), counter, value);
+				return out;
+			}
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				const FunctionCall* call = static_cast<const FunctionCall*>(node);
+
+				std::unique_ptr<FunctionCall> out = std::make_unique<FunctionCall>();
+				out->setFlags(call->getFlags());
+				out->funcName.name = call->funcName.name;
+				copyBody(call->args, out->args);
+				return out;
+			}
+
+			case ASTNode::NodeType::STRING_LITERAL:
+				return std::make_unique<StringLiteral>(static_cast<const StringLiteral*>(node)->value);
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+			{
+				std::unique_ptr<BracketedExpression> out = std::make_unique<BracketedExpression>();
+				out->expr = copyWithValue(static_cast<const BracketedExpression*>(node)->expr.get(), counter, value);
+				return out;
+			}
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+			{
+				std::unique_ptr<TupleExpression> out = std::make_unique<TupleExpression>();
+				copyBody(static_cast<const TupleExpression*>(node)->values, out->values);
+				return out;
+			}
+
+			case ASTNode::NodeType::IF_STATEMENT:
+			{
+				const IfStatement* ifStatement = static_cast<const IfStatement*>(node);
+
+				std::unique_ptr<IfStatement> out = std::make_unique<IfStatement>(ifStatement->type);
+				out->condition = copyWithValue(ifStatement->condition.get(), counter, value);
+				copyBody(ifStatement->body, out->body);
+
+				if (ifStatement->next != nullptr)
+				{
+					out->next.reset(static_cast<IfStatement*>(copyWithValue(ifStatement->next.get(), counter, value).release()));
+				}
+
+				return out;
+			}
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				const LoopStatement* loopStatement = static_cast<const LoopStatement*>(node);
+
+				std::unique_ptr<LoopStatement> out = std::make_unique<LoopStatement>(loopStatement->loopType);
+				out->init = copyWithValue(loopStatement->init.get(), counter, value);
+				out->condition = copyWithValue(loopStatement->condition.get(), counter, value);
+				out->step = copyWithValue(loopStatement->step.get(), counter, value);
+				copyBody(loopStatement->body, out->body);
+				return out;
+			}
+
+			case ASTNode::NodeType::JUMP_STATEMENT:
+				return std::make_unique<JumpStatement>(static_cast<const JumpStatement*>(node)->jumpType);
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+			{
+				std::unique_ptr<ReturnStatement> out = std::make_unique<ReturnStatement>();
+				out->expr = copyWithValue(static_cast<const ReturnStatement*>(node)->expr.get(), counter, value);
+				return out;
+			}
+
+			default:
+				return std::make_unique<Identifier>("DEFAULT");
+		}
+	}
+
+	// Unrolls the loops of the block (inner loops first so their copies are counted in the size of the outer loop)
+	static size_t unrollBlock(LX::Parser::AST& body, size_t limit, const std::unordered_set<std::string>& referenceFunctions)
+	{
+		using namespace LX::Parser;
+
+		size_t unrolled = 0;
+
+		AST out;
+		out.reserve(body.size());
+
+		for (std::unique_ptr<ASTNode>& statement : body)
+		{
+			if (statement != nullptr && statement->type == ASTNode::NodeType::IF_STATEMENT)
+			{
+				for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+				{
+					unrolled += unrollBlock(branch->body, limit, referenceFunctions);
+				}
+			}
+
+			if (statement == nullptr || statement->type != ASTNode::NodeType::LOOP_STATEMENT)
+			{
+				out.push_back(std::move(statement));
+				continue;
+			}
+
+			LoopStatement* loopStatement = static_cast<LoopStatement*>(statement.get());
+
+			unrolled += unrollBlock(loopStatement->body, limit, referenceFunctions);
+
+			std::string counter;
+			std::vector<long long> values;
+
+			if (countedValues(loopStatement, limit, counter, values) == false || canUnroll(loopStatement->body, counter, referenceFunctions) == false)
+			{
+				out.push_back(std::move(statement));
+				continue;
+			}
+
+			size_t size = 0;
+
+			for (std::unique_ptr<ASTNode>& bodyStatement : loopStatement->body)
+			{
+				walk(bodyStatement.get(), [&](ASTNode*) { size++; });
+			}
+
+			if (size * values.size() > UNROLLED_NODE_LIMIT)
+			{
+				out.push_back(std::move(statement));
+				continue;
+			}
+
+			// The counter only exists inside the loop so nothing is left of it
+			for (long long value : values)
+			{
+				for (const std::unique_ptr<ASTNode>& bodyStatement : loopStatement->body)
+				{
+					out.push_back(copyWithValue(bodyStatement.get(), counter, value));
+				}
+			}
+
+			unrolled++;
+		}
+
+		body = std::move(out);
+		return unrolled;
+	}
+
+	size_t unrollLoops(LX::Parser::FunctionDeclaration& func, size_t limit, const std::unordered_set<std::string>& referenceFunctions)
+	{
+		return unrollBlock(func.body, limit, referenceFunctions);
+	}
+
+	// -- Loop invariants -- //
+
+	class InvariantHoister
+	{
+		private:
+			const std::unordered_set<std::string>& referenceFunctions;
+
+			// Variables that are only ever declared as a plain int (the moved expressions are stored as ints)
+			std::unordered_set<std::string> intVariables;
+
+			// Every name used by the function (the new variables are given names that are not in here)
+			std::unordered_set<std::string> usedNames;
+			size_t nextName = 0;
+
+			// Variables that are written to or declared within the current loop
+			std::unordered_set<std::string> changing;
+
+			// Declarations of the expressions moved out of the current loop
+			LX::Parser::AST hoisted;
+
+			// Returns true if the variable (or literal) is the same on every run of the loop
+			bool isInvariantLeaf(std::unique_ptr<LX::Parser::ASTNode>& leaf);
+
+			// Moves the parts of the expression that are the same on every run out of the loop
+			// Returns true if the whole expression is the same on every run (it is then left for the caller to move)
+			bool visitTree(Expression& tree);
+			bool visitExpression(std::unique_ptr<LX::Parser::ASTNode>& node, bool moveWhole);
+			void visitStatement(std::unique_ptr<LX::Parser::ASTNode>& node);
+
+			// Moves the expression into a new const variable
+			void hoist(Expression& tree);
+
+			void hoistLoop(LX::Parser::LoopStatement* loopStatement);
+
+		public:
+			size_t moved = 0;
+
+			InvariantHoister(LX::Parser::FunctionDeclaration& func, const std::unordered_set<std::string>& referenceFunctions);
+
+			void hoistBlock(LX::Parser::AST& body);
+	};
+
+	InvariantHoister::InvariantHoister(LX::Parser::FunctionDeclaration& func, const std::unordered_set<std::string>& referenceFunctions)
+		: referenceFunctions(referenceFunctions)
+	{
+		using namespace LX::Parser;
+
+		// Names that are declared as anything else (even once) are never treated as ints
+		std::unordered_set<std::string> otherVariables;
+
+		auto addVariable = [&](const VariableDeclaration* var)
+		{
+			usedNames.insert(var->name.name);
+
+			// References could be changed through the variable they refer to and a static variable by a call of the function
+			bool isPlainInt = var->varType.name == "int" && var->isUnsigned() == false && var->isReference() == false && var->isPointer() == false && (var->isStatic() == false || var->isConst());
+
+			(isPlainInt ? intVariables : otherVariables).insert(var->name.name);
+		};
+
+		for (const std::unique_ptr<ASTNode>& arg : func.args)
+		{
+			addVariable(static_cast<const VariableDeclaration*>(arg.get()));
+		}
+
+		walk(func, [&](ASTNode* node)
+		{
+			if (node->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+			{
+				addVariable(static_cast<VariableDeclaration*>(node));
+			}
+
+			else if (node->type == ASTNode::NodeType::IDENTIFIER)
+			{
+				usedNames.insert(static_cast<Identifier*>(node)->name);
+			}
+
+			// The variables of a destructuring declaration are also walked but their type depends on the function that was called
+			else if (node->type == ASTNode::NodeType::DESTRUCTURING_DECLARATION)
+			{
+				for (std::unique_ptr<VariableDeclaration>& var : static_cast<DestructuringDeclaration*>(node)->vars)
+				{
+					otherVariables.insert(var->name.name);
+				}
+			}
+		});
+
+		for (const std::string& name : otherVariables)
+		{
+			intVariables.erase(name);
+		}
+	}
+
+	bool InvariantHoister::isInvariantLeaf(std::unique_ptr<LX::Parser::ASTNode>& leaf)
+	{
+		using namespace LX::Parser;
+
+		switch (leaf->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				Constant value = literalValue(leaf.get());
+
+				// Other literals (such as floats) are left where they are as the variable is an int
+				if (value.isKnown()) { return value.type == Constant::Type::INT || value.type == Constant::Type::BOOL; }
+
+				const std::string& name = static_cast<Identifier*>(leaf.get())->name;
+
+				return intVariables.find(name) != intVariables.end() && changing.find(name) == changing.end();
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				return visitExpression(static_cast<BracketedExpression*>(leaf.get())->expr, false);
+
+			// Calls are never moved but their arguments can be
+			case ASTNode::NodeType::FUNCTION_CALL:
+				for (std::unique_ptr<ASTNode>& arg : static_cast<FunctionCall*>(leaf.get())->args)
+				{
+					visitExpression(arg, true);
+				}
+
+				return false;
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+				for (std::unique_ptr<ASTNode>& value : static_cast<TupleExpression*>(leaf.get())->values)
+				{
+					visitExpression(value, true);
+				}
+
+				return false;
+
+			default:
+				return false;
+		}
+	}
+
+	bool InvariantHoister::visitTree(Expression& tree)
+	{
+		switch (tree.kind)
+		{
+			case Expression::Kind::LEAF:
+				return tree.leaf != nullptr && isInvariantLeaf(tree.leaf);
+
+			// Increments and decrements change their operand
+			case Expression::Kind::PREFIX:
+			case Expression::Kind::POSTFIX:
+				if (tree.op == TokenType::INCREMENT || tree.op == TokenType::DECREMENT) { return false; }
+
+				return visitTree(*tree.lhs);
+
+			default:
+			{
+				// The left side of an assignment is written to so only the value can be moved
+				if (isAssignmentOperator(tree.op))
+				{
+					if (visitTree(*tree.rhs)) { hoist(*tree.rhs); }
+					return false;
+				}
+
+				bool lhs = visitTree(*tree.lhs);
+				bool rhs = visitTree(*tree.rhs);
+
+				// Calculating a division before the loop could divide by zero where the loop (or an if within it) would not have
+				long long divisor = 0;
+				bool canTrap = (tree.op == TokenType::DIVIDE || tree.op == TokenType::MODULO) && (tree.rhs->kind != Expression::Kind::LEAF || intLiteral(tree.rhs->leaf.get(), divisor) == false || divisor == 0);
+
+				if (lhs && rhs && canTrap == false) { return true; }
+
+				if (lhs) { hoist(*tree.lhs); }
+				if (rhs) { hoist(*tree.rhs); }
+
+				return false;
+			}
+		}
+	}
+
+	bool InvariantHoister::visitExpression(std::unique_ptr<LX::Parser::ASTNode>& node, bool moveWhole)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return false; }
+
+		// A variable or literal on its own is not worth moving
+		if (node->type == ASTNode::NodeType::IDENTIFIER || node->type == ASTNode::NodeType::STRING_LITERAL)
+		{
+			return isInvariantLeaf(node);
+		}
+
+		std::unique_ptr<Expression> tree = toTree(node);
+
+		// The parser failed on part of the expression
+		if (tree == nullptr) { return false; }
+
+		bool isInvariant = visitTree(*tree);
+
+		if (isInvariant && moveWhole) { hoist(*tree); }
+
+		node = fromTree(std::move(tree));
+		return isInvariant;
+	}
+
+	void InvariantHoister::visitStatement(std::unique_ptr<LX::Parser::ASTNode>& node)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+			{
+				VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(node.get());
+
+				if (varDecl->val != nullptr) { visitExpression(varDecl->val->val, true); }
+				return;
+			}
+
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+				visitExpression(static_cast<DestructuringDeclaration*>(node.get())->val, true);
+				return;
+
+			case ASTNode::NodeType::ASSIGNMENT:
+				visitExpression(static_cast<Assignment*>(node.get())->val, true);
+				return;
+
+			case ASTNode::NodeType::IF_STATEMENT:
+				for (IfStatement* branch = static_cast<IfStatement*>(node.get()); branch != nullptr; branch = branch->next.get())
+				{
+					visitExpression(branch->condition, true);
+
+					for (std::unique_ptr<ASTNode>& statement : branch->body)
+					{
+						visitStatement(statement);
+					}
+				}
+
+				return;
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(node.get());
+
+				visitStatement(loopStatement->init);
+				visitExpression(loopStatement->condition, true);
+
+				for (std::unique_ptr<ASTNode>& statement : loopStatement->body)
+				{
+					visitStatement(statement);
+				}
+
+				visitStatement(loopStatement->step);
+				return;
+			}
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+				visitExpression(static_cast<ReturnStatement*>(node.get())->expr, true);
+				return;
+
+			case ASTNode::NodeType::JUMP_STATEMENT:
+				return;
+
+			// An expression on its own is only run for what it does so only its parts are moved
+			default:
+				visitExpression(node, false);
+				return;
+		}
+	}
+
+	void InvariantHoister::hoist(Expression& tree)
+	{
+		using namespace LX::Parser;
+
+		// Only operations (which can be in brackets) are worth a variable of their own
+		const ASTNode* inner = tree.leaf.get();
+
+		while (inner != nullptr && inner->type == ASTNode::NodeType::BRACKETED_EXPRESSION)
+		{
+			inner = static_cast<const BracketedExpression*>(inner)->expr.get();
+		}
+
+		bool isOperation = tree.kind == Expression::Kind::BINARY || tree.kind == Expression::Kind::PREFIX || (inner != nullptr && (inner->type == ASTNode::NodeType::OPERATION || inner->type == ASTNode::NodeType::UNARY_OPERATION));
+
+		if (isOperation == false) { return; }
+
+		// Operations on literals are left for constant folding
+		bool readsVariable = false;
+
+		std::function<void(const Expression&)> findVariable = [&](const Expression& part)
+		{
+			if (part.kind != Expression::Kind::LEAF)
+			{
+				findVariable(*part.lhs);
+				if (part.rhs != nullptr) { findVariable(*part.rhs); }
+				return;
+			}
+
+			walk(part.leaf.get(), [&](ASTNode* node)
+			{
+				readsVariable = readsVariable || (node->type == ASTNode::NodeType::IDENTIFIER && literalValue(node).isKnown() == false);
+			});
+		};
+
+		findVariable(tree);
+
+		if (readsVariable == false) { return; }
+
+		std::string name;
+
+		do
+		{
+			name = "lx_invariant_" + std::to_string(nextName++);
+		}
+		while (usedNames.find(name) != usedNames.end());
+
+		usedNames.insert(name);
+
+		std::unique_ptr<Expression> value = std::make_unique<Expression>(std::move(tree));
+		tree.makeLeaf(std::make_unique<Identifier>(name));
+
+		std::unique_ptr<VariableDeclaration> varDecl = std::make_unique<VariableDeclaration>();
+		varDecl->setConst();
+		varDecl->varType.name = "int";
+		varDecl->name.name = name;
+		varDecl->val = std::make_unique<Assignment>();
+		varDecl->val->val = fromTree(std::move(value));
+
+		hoisted.push_back(std::move(varDecl));
+		moved++;
+	}
+
+	void InvariantHoister::hoistLoop(LX::Parser::LoopStatement* loopStatement)
+	{
+		using namespace LX::Parser;
+
+		changing.clear();
+
+		// Variables declared in the loop are new on each run (or are the counter of a for loop)
+		walk(loopStatement, [&](ASTNode* node)
+		{
+			addWrittenVariable(node, referenceFunctions, changing);
+
+			if (node->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+			{
+				changing.insert(static_cast<VariableDeclaration*>(node)->name.name);
+			}
+		});
+
+		// The init is only run once so is left as it is
+		visitExpression(loopStatement->condition, true);
+
+		for (std::unique_ptr<ASTNode>& statement : loopStatement->body)
+		{
+			visitStatement(statement);
+		}
+
+		visitStatement(loopStatement->step);
+	}
+
+	void InvariantHoister::hoistBlock(LX::Parser::AST& body)
+	{
+		using namespace LX::Parser;
+
+		AST out;
+		out.reserve(body.size());
+
+		for (std::unique_ptr<ASTNode>& statement : body)
+		{
+			if (statement != nullptr && statement->type == ASTNode::NodeType::IF_STATEMENT)
+			{
+				for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+				{
+					hoistBlock(branch->body);
+				}
+			}
+
+			// Outer loops are done first so an expression is moved out of as many loops as it can be
+			else if (statement != nullptr && statement->type == ASTNode::NodeType::LOOP_STATEMENT)
+			{
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(statement.get());
+
+				hoistLoop(loopStatement);
+
+				for (std::unique_ptr<ASTNode>& declaration : hoisted)
+				{
+					out.push_back(std::move(declaration));
+				}
+
+				hoisted.clear();
+
+				hoistBlock(loopStatement->body);
+			}
+
+			out.push_back(std::move(statement));
+		}
+
+		body = std::move(out);
+	}
+
+	size_t hoistLoopInvariants(LX::Parser::FunctionDeclaration& func, const std::unordered_set<std::string>& referenceFunctions)
+	{
+		InvariantHoister hoister(func, referenceFunctions);
+		hoister.hoistBlock(func.body);
+
+		return hoister.moved;
+	}
+}
@@ -0,0 +1,380 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <optimizer.h>
+
+#include <common.h>
+
+#include <compile-time-calls.h>
+#include <constant-folding.h>
+#include <dead-functions.h>
+#include <dead-stores.h>
+#include <inliner.h>
+#include <loops.h>
+#include <reference-params.h>
+#include <static-constants.h>
+
+namespace LX::Optimizer
+{
+	bool Options::set(const std::string& name, bool enabled)
+	{
+		if (name == "inlining") { inlining = enabled; }
+		else if (name == "constant-folding") { constantFolding = enabled; }
+		else if (name == "compile-time-calls") { compileTimeCalls = enabled; }
+		else if (name == "dead-functions") { deadFunctions = enabled; }
+		else if (name == "dead-stores") { deadStores = enabled; }
+		else if (name == "static-constants") { staticConstants = enabled; }
+		else if (name == "reference-params") { referenceParams = enabled; }
+		else if (name == "loop-unrolling") { loopUnrolling = enabled; }
+		else if (name == "loop-invariants") { loopInvariants = enabled; }
+		else if (name == "report") { report = enabled; }
+
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Options::setLimit(const std::string& name, size_t value)
+	{
+		if (name == "inline-threshold") { inlineThreshold = value; }
+		else if (name == "unroll-limit") { unrollLimit = value; }
+
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Options::setProfile(const std::string& profile)
+	{
+		// Keeps the C++ output as close to the source as possible
+		if (profile == "debug")
+		{
+			inlining = false;
+			constantFolding = false;
+			compileTimeCalls = false;
+			deadFunctions = false;
+			deadStores = false;
+			staticConstants = false;
+			referenceParams = false;
+			loopUnrolling = false;
+			loopInvariants = false;
+		}
+
+		else if (profile == "release")
+		{
+			inlining = true;
+			constantFolding = true;
+			compileTimeCalls = true;
+			deadFunctions = true;
+			deadStores = true;
+			staticConstants = true;
+			referenceParams = true;
+			loopUnrolling = true;
+			loopInvariants = true;
+		}
+
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	// Information about the whole project that is needed by the optimizations of a single function
+	struct ProjectInfo
+	{
+		// Functions that can write to their arguments
+		std::unordered_set<std::string> referenceFunctions;
+	};
+
+	// State of a function between the steps that optimize every function in parallel
+	struct FunctionState
+	{
+		ConstantFolder folder;
+		Diagnostics diagnostics;
+
+		// Set when calls of the function were replaced with their results (or loops were unrolled) after it was folded
+		bool hasNewLiterals = false;
+	};
+
+	// Folds the function again after the results of calls were added to it
+	// The warnings of the first fold are not given again
+	static void refold(LX::Parser::FunctionDeclaration& func, FunctionState& state)
+	{
+		Diagnostics diagnostics;
+		state.folder.fold(func, diagnostics);
+
+		std::vector<std::string>& warnings = state.diagnostics.warnings;
+
+		for (const std::string& warning : diagnostics.warnings)
+		{
+			if (std::find(warnings.begin(), warnings.end(), warning) == warnings.end())
+			{
+				warnings.push_back(warning);
+			}
+		}
+	}
+
+	// Runs the optimizations that only look at a single function (after it was folded and its calls were evaluated)
+	static void optimizeFunction(LX::Parser::FunctionDeclaration& func, const Options& options, const ProjectInfo& project, FunctionState& state)
+	{
+		Diagnostics& out = state.diagnostics;
+
+		// Runs after the first fold so loops counting to a const variable have a literal as their bound
+		// The counter is replaced with a literal in each copy so the copies are folded again
+		if (options.loopUnrolling)
+		{
+			size_t unrolled = unrollLoops(func, options.unrollLimit, project.referenceFunctions);
+
+			if (unrolled != 0)
+			{
+				state.hasNewLiterals = true;
+				out.notes.push_back("Loop unrolling: " + func.name.name + ": " + std::to_string(unrolled) + " loops unrolled");
+			}
+		}
+
+		if (options.constantFolding)
+		{
+			if (state.hasNewLiterals)
+			{
+				refold(func, state);
+			}
+
+			const ConstantFolder& folder = state.folder;
+
+			if (folder.folded != 0 || folder.propagated != 0)
+			{
+				out.notes.push_back("Constant folding: " + func.name.name + ": " + std::to_string(folder.folded) + " operations folded, " + std::to_string(folder.propagated) + " constants propagated");
+			}
+		}
+
+		// Runs after constant folding as the constants that were propagated may no longer be used
+		if (options.deadStores)
+		{
+			DeadStoreEliminator eliminator;
+			eliminator.eliminate(func);
+
+			if (eliminator.removedStores != 0 || eliminator.removedVariables.empty() == false)
+			{
+				std::string note = "Dead store elimination: " + func.name.name + ": " + std::to_string(eliminator.removedStores) + " stores removed, " + std::to_string(eliminator.removedVariables.size()) + " unused variables removed";
+
+				for (size_t i = 0; i < eliminator.removedVariables.size(); i++)
+				{
+					note += (i == 0 ? " (" : ", ") + eliminator.removedVariables[i];
+				}
+
+				out.notes.push_back(eliminator.removedVariables.empty() ? note : note + ")");
+			}
+		}
+
+		// Runs after dead store elimination so the new variables are never seen as unused
+		if (options.loopInvariants)
+		{
+			size_t moved = hoistLoopInvariants(func, project.referenceFunctions);
+
+			if (moved != 0)
+			{
+				out.notes.push_back("Loop invariants: " + func.name.name + ": " + std::to_string(moved) + " expressions moved out of loops");
+			}
+		}
+
+		// Runs after dead store elimination so variables that were removed are not reported
+		if (options.staticConstants)
+		{
+			std::vector<std::string> hoisted = hoistConstants(func);
+
+			if (hoisted.empty() == false)
+			{
+				std::string note = "Static constants: " + func.name.name + ": ";
+
+				for (size_t i = 0; i < hoisted.size(); i++)
+				{
+					note += (i == 0 ? "" : ", ") + hoisted[i];
+				}
+
+				out.notes.push_back(note + " created once");
+			}
+		}
+
+		// Runs after dead store elimination as a parameter may only have been written to by a dead store
+		if (options.referenceParams)
+		{
+			std::vector<std::string> changed = passParametersByReference(func, project.referenceFunctions);
+
+			if (changed.empty() == false)
+			{
+				std::string note = "Reference parameters: " + func.name.name + ": ";
+
+				for (size_t i = 0; i < changed.size(); i++)
+				{
+					note += (i == 0 ? "" : ", ") + changed[i];
+				}
+
+				out.notes.push_back(note + " passed by const reference");
+			}
+		}
+	}
+
+	// Lists the names in the order they were first seen without repeating any
+	static std::string listNames(const std::vector<std::string>& names)
+	{
+		std::vector<std::string> listed;
+		std::string out;
+
+		for (const std::string& name : names)
+		{
+			if (std::find(listed.begin(), listed.end(), name) == listed.end())
+			{
+				out += (listed.empty() ? "" : ", ") + name;
+				listed.push_back(name);
+			}
+		}
+
+		return out;
+	}
+
+	static void printDiagnostics(const Diagnostics& messages, const Options& options)
+	{
+		for (const std::string& warning : messages.warnings)
+		{
+			std::cout << "WARNING: " << warning << std::endl;
+		}
+
+		if (options.report == false) { return; }
+
+		for (const std::string& note : messages.notes)
+		{
+			std::cout << note << std::endl;
+		}
+	}
+
+	Report optimize(const std::vector<LX::Parser::FileAST*>& files, const Options& options)
+	{
+		// Optimizations that need to see the whole project
+		// Dead functions are removed first so no time is spent optimizing them
+		Diagnostics projectDiagnostics;
+
+		if (options.deadFunctions)
+		{
+			eliminateDeadFunctions(files, projectDiagnostics);
+		}
+
+		printDiagnostics(projectDiagnostics, options);
+
+		// Every function of the project in the order of the files
+		std::vector<LX::Parser::FunctionDeclaration*> functions;
+
+		for (LX::Parser::FileAST* file : files)
+		{
+			for (LX::Parser::FunctionDeclaration& func : file->functions)
+			{
+				functions.push_back(&func);
+			}
+		}
+
+		// Collected before any function is changed
+		ProjectInfo project;
+		project.referenceFunctions = functionsWithReferenceParameters(files);
+
+		// Functions share no state so are optimized in parallel
+		std::vector<FunctionState> states(functions.size());
+
+		Report report;
+
+		// Inlined before anything else so the inlined expressions are optimized as part of the function they are in
+		// The inliner reads the bodies of the other functions so this is done one function at a time
+		if (options.inlining)
+		{
+			Inliner inliner(files, options.inlineThreshold);
+
+			for (size_t i = 0; i < functions.size(); i++)
+			{
+				std::vector<std::string> inlined = inliner.inlineCalls(*functions[i], report.inlining);
+
+				if (inlined.empty() == false)
+				{
+					states[i].diagnostics.notes.push_back("Inlining: " + functions[i]->name.name + ": " + std::to_string(inlined.size()) + " calls inlined (" + listNames(inlined) + ")");
+				}
+			}
+		}
+
+		// Folded first so the arguments of calls are literals where possible
+		if (options.constantFolding)
+		{
+			LX::Thread::parallelFor(functions.size(), [&](size_t i)
+			{
+				states[i].folder.fold(*functions[i], states[i].diagnostics);
+			});
+		}
+
+		// The evaluator reads the bodies of the other functions so this is done one function at a time
+		if (options.compileTimeCalls)
+		{
+			CompileTimeEvaluator evaluator(functions);
+
+			for (size_t i = 0; i < functions.size(); i++)
+			{
+				std::vector<std::string> replaced = replaceCompileTimeCalls(*functions[i], evaluator, states[i].diagnostics);
+
+				if (replaced.empty()) { continue; }
+
+				states[i].hasNewLiterals = true;
+
+				states[i].diagnostics.notes.push_back("Compile time calls: " + functions[i]->name.name + ": " + std::to_string(replaced.size()) + " calls replaced with their results (" + listNames(replaced) + ")");
+			}
+		}
+
+		LX::Thread::parallelFor(functions.size(), [&](size_t i)
+		{
+			optimizeFunction(*functions[i], options, project, states[i]);
+		});
+
+		for (const FunctionState& state : states)
+		{
+			printDiagnostics(state.diagnostics, options);
+		}
+
+		return report;
+	}
+}
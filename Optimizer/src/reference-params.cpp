@@ -0,0 +1,217 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <reference-params.h>
+
+#include <common.h>
+
+#include <ast-walk.h>
+#include <expression.h>
+
+namespace LX::Optimizer
+{
+	// Returns the variable a node refers to (or null if it is not a variable)
+	static LX::Parser::Identifier* variableOf(LX::Parser::ASTNode* node)
+	{
+		using namespace LX::Parser;
+
+		// Brackets around a variable still refer to the variable
+		while (node != nullptr && node->type == ASTNode::NodeType::BRACKETED_EXPRESSION)
+		{
+			node = static_cast<BracketedExpression*>(node)->expr.get();
+		}
+
+		if (node == nullptr || node->type != ASTNode::NodeType::IDENTIFIER) { return nullptr; }
+
+		return static_cast<Identifier*>(node);
+	}
+
+	// Returns the first operand of an operation chain
+	// A prefix operator applies to the rest of the chain in the AST but only to the first operand in C++
+	static LX::Parser::ASTNode* firstOperand(LX::Parser::ASTNode* node)
+	{
+		using namespace LX::Parser;
+
+		while (node != nullptr && node->type == ASTNode::NodeType::OPERATION)
+		{
+			node = static_cast<Operation*>(node)->lhs.get();
+		}
+
+		return node;
+	}
+
+	void addWrittenVariable(LX::Parser::ASTNode* node, const std::unordered_set<std::string>& referenceFunctions, std::unordered_set<std::string>& written)
+	{
+		using namespace LX::Parser;
+		using namespace LX::Lexer;
+
+		// Adds the variable a node refers to
+		auto add = [&](ASTNode* target)
+		{
+			if (Identifier* var = variableOf(target); var != nullptr) { written.insert(var->name); }
+		};
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::ASSIGNMENT:
+				written.insert(static_cast<Assignment*>(node)->name.name);
+				return;
+
+			case ASTNode::NodeType::OPERATION:
+				if (isAssignmentOperator(static_cast<Operation*>(node)->op)) { add(static_cast<Operation*>(node)->lhs.get()); }
+				return;
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				UnaryOperation* unary = static_cast<UnaryOperation*>(node);
+
+				if (unary->op == TokenType::INCREMENT || unary->op == TokenType::DECREMENT)
+				{
+					add(unary->side == UnaryOperation::Sided::LEFT ? firstOperand(unary->val.get()) : unary->val.get());
+				}
+
+				return;
+			}
+
+			// The callee could write to the argument through its reference parameter
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				FunctionCall* call = static_cast<FunctionCall*>(node);
+
+				if (referenceFunctions.find(call->funcName.name) == referenceFunctions.end()) { return; }
+
+				for (std::unique_ptr<ASTNode>& arg : call->args)
+				{
+					add(arg.get());
+				}
+
+				return;
+			}
+
+			// The variable could be written to through a (non const) reference to it
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+			{
+				VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(node);
+
+				if (varDecl->isReference() && varDecl->isConst() == false && varDecl->val != nullptr)
+				{
+					add(varDecl->val->val.get());
+				}
+
+				return;
+			}
+
+			default:
+				return;
+		}
+	}
+
+	std::unordered_set<std::string> functionsWithReferenceParameters(const std::vector<LX::Parser::FileAST*>& files)
+	{
+		std::unordered_set<std::string> names;
+
+		for (LX::Parser::FileAST* file : files)
+		{
+			for (LX::Parser::FunctionDeclaration& func : file->functions)
+			{
+				for (std::unique_ptr<LX::Parser::ASTNode>& arg : func.args)
+				{
+					LX::Parser::VariableDeclaration* param = static_cast<LX::Parser::VariableDeclaration*>(arg.get());
+
+					if (param->isReference() && param->isConst() == false)
+					{
+						names.insert(func.name.name);
+					}
+				}
+			}
+		}
+
+		return names;
+	}
+
+	std::vector<std::string> passParametersByReference(LX::Parser::FunctionDeclaration& func, const std::unordered_set<std::string>& referenceFunctions)
+	{
+		std::vector<std::string> changed;
+
+		// A parameter could change while the function is running if it is passed the same variable as a reference parameter
+		if (referenceFunctions.find(func.name.name) != referenceFunctions.end()) { return changed; }
+
+		// Every name that is written to within the function (including local variables with the same name as a parameter)
+		std::unordered_set<std::string> written;
+
+		walk(func, [&](LX::Parser::ASTNode* node)
+		{
+			addWrittenVariable(node, referenceFunctions, written);
+
+			// A return of a call to the function itself is translated to assigning the arguments to the parameters (Translator/inc/tail-calls.h)
+			if (node->type != LX::Parser::ASTNode::NodeType::RETURN_STATEMENT) { return; }
+
+			LX::Parser::ASTNode* expr = static_cast<LX::Parser::ReturnStatement*>(node)->expr.get();
+
+			if (expr == nullptr || expr->type != LX::Parser::ASTNode::NodeType::FUNCTION_CALL) { return; }
+
+			LX::Parser::FunctionCall* call = static_cast<LX::Parser::FunctionCall*>(expr);
+
+			if (call->funcName.name != func.name.name || call->args.size() != func.args.size()) { return; }
+
+			for (size_t i = 0; i < call->args.size(); i++)
+			{
+				const std::string& name = static_cast<LX::Parser::VariableDeclaration*>(func.args[i].get())->name.name;
+				LX::Parser::Identifier* var = variableOf(call->args[i].get());
+
+				if (var == nullptr || var->name != name) { written.insert(name); }
+			}
+		});
+
+		for (std::unique_ptr<LX::Parser::ASTNode>& arg : func.args)
+		{
+			LX::Parser::VariableDeclaration* param = static_cast<LX::Parser::VariableDeclaration*>(arg.get());
+
+			// Ints are cheaper to copy than to reference
+			if (param->varType.name != "string" || param->isReference()) { continue; }
+
+			if (written.find(param->name.name) != written.end()) { continue; }
+
+			param->setConst();
+			param->setReference();
+
+			changed.push_back(param->name.name);
+		}
+
+		return changed;
+	}
+}
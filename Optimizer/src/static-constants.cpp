@@ -0,0 +1,89 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <static-constants.h>
+
+#include <common.h>
+
+#include <ast-walk.h>
+
+namespace LX::Optimizer
+{
+	bool isLiteral(const LX::Parser::ASTNode* node)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return false; }
+
+		if (node->type == ASTNode::NodeType::STRING_LITERAL) { return true; }
+
+		if (node->type != ASTNode::NodeType::IDENTIFIER) { return false; }
+
+		// Numbers are stored as identifiers (including negative numbers and numbers with a decimal point)
+		const std::string& name = static_cast<const Identifier*>(node)->name;
+
+		if (name == "true" || name == "false") { return true; }
+
+		size_t start = (name.size() > 1 && name[0] == '-') ? 1 : 0;
+
+		return name.empty() == false && name[start] >= '0' && name[start] <= '9';
+	}
+
+	std::vector<std::string> hoistConstants(LX::Parser::FunctionDeclaration& func)
+	{
+		using namespace LX::Parser;
+
+		std::vector<std::string> hoisted;
+
+		walk(func, [&](ASTNode* node)
+		{
+			if (node->type != ASTNode::NodeType::VARIABLE_DECLARATION) { return; }
+
+			VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(node);
+
+			// A reference to a literal has to be to a new object each time
+			if (varDecl->isConst() == false || varDecl->isStatic() || varDecl->isReference()) { return; }
+
+			if (varDecl->val == nullptr || isLiteral(varDecl->val->val.get()) == false) { return; }
+
+			varDecl->setStatic();
+			hoisted.push_back(varDecl->name.name);
+		});
+
+		return hoisted;
+	}
+}
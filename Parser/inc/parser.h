@@ -51,6 +51,9 @@ namespace LX::Parser
 		// Current index in the tokens
 		size_t currentIndex = 0;
 
+		// Number of loops around the current statement (break and continue are only valid inside one)
+		size_t loopDepth = 0;
+
 		std::vector<std::unique_ptr<ASTNode>> parseBlock();
 
 		std::unique_ptr<ASTNode> parsePrimary();
@@ -65,8 +68,10 @@ namespace LX::Parser
 		std::unique_ptr<ASTNode> parseReturnStatement();
 
 		std::unique_ptr<ASTNode> parseVariableDeclaration();
+		std::unique_ptr<ASTNode> parseDestructuringDeclaration();
 
 		std::unique_ptr<ASTNode> parseIfStatement();
+		std::unique_ptr<ASTNode> parseLoopStatement();
 
 		FunctionDeclaration parseFunctionDeclaration();
 
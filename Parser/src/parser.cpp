@@ -142,9 +142,20 @@ namespace LX::Parser
 				// Var Types
 			case TokenType::INT_DEC:
 			case TokenType::STR_DEC:
+			case TokenType::I8_DEC:
+			case TokenType::I16_DEC:
+			case TokenType::I32_DEC:
+			case TokenType::I64_DEC:
+			case TokenType::U8_DEC:
+			case TokenType::U16_DEC:
+			case TokenType::U32_DEC:
+			case TokenType::U64_DEC:
+			case TokenType::F32_DEC:
+			case TokenType::F64_DEC:
 
 				// Var Modifiers
 			case TokenType::CONST:
+			case TokenType::STATIC:
 
 				// Returns true if the token is a variable declaration
 				return true;
@@ -155,6 +166,41 @@ namespace LX::Parser
 			}
 		}
 
+		// Returns the number of bits of a fixed width integer type (or 0 if the token is not one)
+		constexpr int integerBits(LX::Lexer::TokenType type)
+		{
+			using namespace LX::Lexer;
+
+			switch (type)
+			{
+			case TokenType::I8_DEC:
+			case TokenType::U8_DEC:
+				return 8;
+
+			case TokenType::I16_DEC:
+			case TokenType::U16_DEC:
+				return 16;
+
+			case TokenType::I32_DEC:
+			case TokenType::U32_DEC:
+				return 32;
+
+			case TokenType::I64_DEC:
+			case TokenType::U64_DEC:
+				return 64;
+
+			default:
+				return 0;
+			}
+		}
+
+		constexpr bool isUnsignedType(LX::Lexer::TokenType type)
+		{
+			using namespace LX::Lexer;
+
+			return type == TokenType::U8_DEC || type == TokenType::U16_DEC || type == TokenType::U32_DEC || type == TokenType::U64_DEC;
+		}
+
 		constexpr bool isVarModifier(LX::Lexer::TokenType type)
 		{
 			using namespace LX::Lexer;
@@ -163,6 +209,7 @@ namespace LX::Parser
 			{
 				// Var Modifiers
 			case TokenType::CONST:
+			case TokenType::STATIC:
 
 				// Returns true if the token is a variable modifier
 				return true;
@@ -208,6 +255,8 @@ namespace LX::Parser
 	// The call stack is as follows:
 	// - parseFunctionDeclaration
 	// - parseIfStatement
+	// - parseLoopStatement
+	// - parseDestructuringDeclaration
 	// - parseVariableDeclaration
 	// - parseAssignment
 	// - parseFunctionCall
@@ -399,6 +448,23 @@ namespace LX::Parser
 			// Parse the value
 			out->expr = parseFunctionCall();
 
+			// Multiple values are returned as a tuple
+			if (currentTokens->operator[](currentIndex).type == LX::Lexer::TokenType::COMMA)
+			{
+				std::unique_ptr<TupleExpression> tuple = std::make_unique<TupleExpression>();
+				tuple->values.push_back(std::move(out->expr));
+
+				while (currentTokens->operator[](currentIndex).type == LX::Lexer::TokenType::COMMA)
+				{
+					// Skip the comma
+					currentIndex++;
+
+					tuple->values.push_back(parseFunctionCall());
+				}
+
+				out->expr = std::move(tuple);
+			}
+
 			// Return the output
 			return out;
 
@@ -425,17 +491,14 @@ namespace LX::Parser
 			}
 
 			// Sets the name of the assignment
-			out->name.name = dynamic_cast<Identifier*>(asignee.get())->name;
+			out->name.name = static_cast<Identifier*>(asignee.get())->name;
 
 			// Skip the assignment operator
 			currentIndex++;
 
-			// Parse the value
+			// Parse the value (this leaves the current token after the value)
 			out->val = parseFunctionCall();
 
-			// Iterate to the next token
-			currentIndex++;
-
 			// Return the output
 			return out;
 		}
@@ -461,6 +524,10 @@ namespace LX::Parser
 						out->setConst();
 						break;
 
+					case LX::Lexer::TokenType::STATIC:
+						out->setStatic();
+						break;
+
 					default:
 						std::cerr << "ERROR: Unknown variable modifier" << std::endl;
 						return nullptr;
@@ -480,11 +547,37 @@ namespace LX::Parser
 			case LX::Lexer::TokenType::STR_DEC:
 				out->varType.name = "string";
 				break;
+
+			case LX::Lexer::TokenType::F32_DEC:
+				out->varType.name = "f32";
+				break;
+
+			case LX::Lexer::TokenType::F64_DEC:
+				out->varType.name = "f64";
+				break;
+
+			default:
+				// Unsigned types are stored as the signed type of the same width with the unsigned flag (u8 is i8)
+				if (int bits = Constexprs::integerBits(currentTokens->operator[](currentIndex).type); bits != 0)
+				{
+					out->varType.name = "i" + std::to_string(bits);
+
+					if (Constexprs::isUnsignedType(currentTokens->operator[](currentIndex).type)) { out->setUnsigned(); }
+				}
+
+				break;
 			}
 
 			// Iterate to the next token
 			currentIndex++;
 
+			// A reference is marked by an & after the type
+			if (currentTokens->operator[](currentIndex).type == LX::Lexer::TokenType::REFERENCE)
+			{
+				out->setReference();
+				currentIndex++;
+			}
+
 			// Set the name of the variable
 			out->name.name = currentTokens->operator[](currentIndex).value;
 
@@ -516,6 +609,66 @@ namespace LX::Parser
 		return parseAssignment();
 	}
 
+	std::unique_ptr<ASTNode> Parser::parseDestructuringDeclaration()
+	{
+		std::unique_ptr<ASTNode> first = parseVariableDeclaration();
+
+		// A declaration followed by a comma declares a variable for each returned value
+		if (first == nullptr || first->type != ASTNode::NodeType::VARIABLE_DECLARATION || currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::COMMA)
+		{
+			return first;
+		}
+
+		// Create the output as a DestructuringDeclaration type to allow access
+		std::unique_ptr<DestructuringDeclaration> out = std::make_unique<DestructuringDeclaration>();
+		out->vars.emplace_back(static_cast<VariableDeclaration*>(first.release()));
+
+		while (currentTokens->operator[](currentIndex).type == LX::Lexer::TokenType::COMMA)
+		{
+			// Only the last variable can have a value
+			if (out->vars.back()->val != nullptr)
+			{
+				std::cerr << "ERROR: Expected a single value after the declared variables" << std::endl;
+				return nullptr;
+			}
+
+			// Skip the comma
+			currentIndex++;
+
+			std::unique_ptr<ASTNode> next = parseVariableDeclaration();
+
+			if (next == nullptr || next->type != ASTNode::NodeType::VARIABLE_DECLARATION)
+			{
+				std::cerr << "ERROR: Expected variable declaration" << std::endl;
+				return nullptr;
+			}
+
+			out->vars.emplace_back(static_cast<VariableDeclaration*>(next.release()));
+		}
+
+		// The value of the last variable is the value of all of them
+		if (out->vars.back()->val == nullptr)
+		{
+			std::cerr << "ERROR: Expected a value for the declared variables" << std::endl;
+			return nullptr;
+		}
+
+		// The value is either created once (for static variables) or on every call so all of the variables must agree
+		for (const std::unique_ptr<VariableDeclaration>& var : out->vars)
+		{
+			if (var->isStatic() != out->vars.front()->isStatic())
+			{
+				std::cerr << "ERROR: Cannot mix static and non-static variables in one declaration" << std::endl;
+				return nullptr;
+			}
+		}
+
+		out->val = std::move(out->vars.back()->val->val);
+		out->vars.back()->val = nullptr;
+
+		return out;
+	}
+
 	std::unique_ptr<ASTNode> Parser::parseIfStatement()
 	{
 		if (currentTokens->operator[](currentIndex).type == LX::Lexer::TokenType::IF)
@@ -610,7 +763,149 @@ namespace LX::Parser
 			return out;
 		}
 
-		return parseVariableDeclaration();
+		return parseLoopStatement();
+	}
+
+	std::unique_ptr<ASTNode> Parser::parseLoopStatement()
+	{
+		switch (currentTokens->operator[](currentIndex).type)
+		{
+			case LX::Lexer::TokenType::WHILE:
+			{
+				// Skip the while token
+				currentIndex++;
+
+				// Create the output as a LoopStatement type to allow access
+				std::unique_ptr<LoopStatement> out = std::make_unique<LoopStatement>(LoopStatement::LoopType::WHILE);
+
+				// Check for the left parenthesis
+				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::LEFT_PAREN)
+				{
+					std::cerr << "ERROR: Expected left parenthesis" << std::endl;
+					return nullptr;
+				}
+
+				// Skip the left parenthesis
+				currentIndex++;
+
+				// Parse the condition
+				out->condition = parseFunctionCall();
+
+				// Check for the right parenthesis
+				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::RIGHT_PAREN)
+				{
+					std::cerr << "ERROR: Expected right parenthesis" << std::endl;
+					return nullptr;
+				}
+
+				// Skip the right parenthesis
+				currentIndex++;
+
+				// Parse the body
+				loopDepth++;
+				out->body = parseBlock();
+				loopDepth--;
+
+				return out;
+			}
+
+			case LX::Lexer::TokenType::FOR:
+			{
+				// Skip the for token
+				currentIndex++;
+
+				// Create the output as a LoopStatement type to allow access
+				std::unique_ptr<LoopStatement> out = std::make_unique<LoopStatement>(LoopStatement::LoopType::FOR);
+
+				// Check for the left parenthesis
+				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::LEFT_PAREN)
+				{
+					std::cerr << "ERROR: Expected left parenthesis" << std::endl;
+					return nullptr;
+				}
+
+				// Skip the left parenthesis
+				currentIndex++;
+
+				// Parse the init (a variable declared here is only visible inside the loop)
+				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::SEMICOLON)
+				{
+					out->init = parseVariableDeclaration();
+				}
+
+				// Check for the first semicolon
+				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::SEMICOLON)
+				{
+					std::cerr << "ERROR: Expected semicolon after the loop init" << std::endl;
+					return nullptr;
+				}
+
+				// Skip the semicolon
+				currentIndex++;
+
+				// Parse the condition (no condition loops until a break or return)
+				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::SEMICOLON)
+				{
+					out->condition = parseFunctionCall();
+				}
+
+				// Check for the second semicolon
+				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::SEMICOLON)
+				{
+					std::cerr << "ERROR: Expected semicolon after the loop condition" << std::endl;
+					return nullptr;
+				}
+
+				// Skip the semicolon
+				currentIndex++;
+
+				// Parse the step
+				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::RIGHT_PAREN)
+				{
+					out->step = parseAssignment();
+				}
+
+				// Check for the right parenthesis
+				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::RIGHT_PAREN)
+				{
+					std::cerr << "ERROR: Expected right parenthesis" << std::endl;
+					return nullptr;
+				}
+
+				// Skip the right parenthesis
+				currentIndex++;
+
+				// Parse the body
+				loopDepth++;
+				out->body = parseBlock();
+				loopDepth--;
+
+				return out;
+			}
+
+			case LX::Lexer::TokenType::BREAK:
+			case LX::Lexer::TokenType::CONTINUE:
+			{
+				// Break and continue only have a meaning inside of a loop
+				if (loopDepth == 0)
+				{
+					std::cerr << "ERROR: " << (currentTokens->operator[](currentIndex).type == LX::Lexer::TokenType::BREAK ? "Break" : "Continue") << " outside of a loop" << std::endl;
+					currentIndex++;
+
+					return nullptr;
+				}
+
+				JumpStatement::JumpType jumpType = currentTokens->operator[](currentIndex).type == LX::Lexer::TokenType::BREAK ? JumpStatement::JumpType::BREAK : JumpStatement::JumpType::CONTINUE;
+
+				// Skip the break or continue token
+				currentIndex++;
+
+				return std::make_unique<JumpStatement>(jumpType);
+			}
+
+			default:
+				return parseDestructuringDeclaration();
+		}
 	}
 
 	FunctionDeclaration Parser::parseFunctionDeclaration()
@@ -626,24 +921,45 @@ namespace LX::Parser
 			// Check for return type
 			if (currentTokens->operator[](currentIndex).type == LX::Lexer::TokenType::LEFT_BRACKET)
 			{
-				currentIndex++;
-
-				switch (currentTokens->operator[](currentIndex).type)
+				// Loops through the return types (separated by commas)
+				do
 				{
-					case LX::Lexer::TokenType::INT_DEC:
-						out.returnTypes.push_back(Identifier("int"));
-						break;
+					currentIndex++;
 
-					case LX::Lexer::TokenType::STR_DEC:
-						out.returnTypes.push_back(Identifier("std::string"));
-						break;
+					switch (currentTokens->operator[](currentIndex).type)
+					{
+						case LX::Lexer::TokenType::INT_DEC:
+							out.returnTypes.push_back(Identifier("int"));
+							break;
 
-					default:
-						break;
+						case LX::Lexer::TokenType::STR_DEC:
+							out.returnTypes.push_back(Identifier("std::string"));
+							break;
+
+						case LX::Lexer::TokenType::F32_DEC:
+							out.returnTypes.push_back(Identifier("float"));
+							break;
+
+						case LX::Lexer::TokenType::F64_DEC:
+							out.returnTypes.push_back(Identifier("double"));
+							break;
+
+						default:
+							// Fixed width integers are the <cstdint> types
+							if (int bits = Constexprs::integerBits(currentTokens->operator[](currentIndex).type); bits != 0)
+							{
+								std::string prefix = Constexprs::isUnsignedType(currentTokens->operator[](currentIndex).type) ? "std::uint" : "std::int";
+								out.returnTypes.push_back(Identifier(prefix + std::to_string(bits) + "_t"));
+							}
+
+							break;
+					}
+
+					currentIndex++;
 				}
+				while (currentTokens->operator[](currentIndex).type == LX::Lexer::TokenType::COMMA);
 
 				// Check for the closing bracket
-				currentIndex++;
 
 				if (currentTokens->operator[](currentIndex).type != LX::Lexer::TokenType::RIGHT_BRACKET)
 				{
@@ -0,0 +1,230 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+// Measures the time the translator takes per AST node on a large generated file
+// Each function is translated by calling assembleNode on its statements so only the translation of the nodes is timed
+// Build with optimizations from this folder along with the translator sources
+// (such as "g++ -O2 -std=c++17 -I../inc -I../../Common/inc dispatch-benchmark.cpp ../src/*.cpp -pthread")
+// The results are written to stdout
+
+#include <translator.h>
+
+#include <chrono>
+#include <cstdlib>
+
+using namespace LX::Parser;
+using LX::Lexer::TokenType;
+
+// Number of functions in the generated file (can be changed by the first argument)
+static constexpr size_t DEFAULT_FUNCTIONS = 20'000;
+
+// Number of times the file is translated (the fastest is used)
+static constexpr int RUNS = 5;
+
+static std::unique_ptr<ASTNode> identifier(const std::string& name)
+{
+	return std::make_unique<Identifier>(name);
+}
+
+static std::unique_ptr<ASTNode> operation(std::unique_ptr<ASTNode> lhs, TokenType op, std::unique_ptr<ASTNode> rhs)
+{
+	std::unique_ptr<Operation> node = std::make_unique<Operation>();
+	node->lhs = std::move(lhs);
+	node->op = op;
+	node->rhs = std::move(rhs);
+
+	return node;
+}
+
+static std::unique_ptr<ASTNode> assignment(const std::string& name, std::unique_ptr<ASTNode> val)
+{
+	std::unique_ptr<Assignment> node = std::make_unique<Assignment>();
+	node->name.name = name;
+	node->val = std::move(val);
+
+	return node;
+}
+
+// Creates a function that declares, changes, checks and prints a few variables the same way most LX code does
+static FunctionDeclaration generateFunction(size_t index)
+{
+	FunctionDeclaration func;
+	func.name.name = "f" + std::to_string(index);
+	func.returnTypes.emplace_back("int");
+
+	for (const char* name : { "a", "b" })
+	{
+		std::unique_ptr<VariableDeclaration> arg = std::make_unique<VariableDeclaration>();
+		arg->varType.name = "int";
+		arg->name.name = name;
+		func.args.push_back(std::move(arg));
+	}
+
+	for (int i = 0; i < 8; i++)
+	{
+		const std::string var = "v" + std::to_string(i);
+
+		// int v<i> = a + <i> * b
+		std::unique_ptr<VariableDeclaration> decl = std::make_unique<VariableDeclaration>();
+		decl->varType.name = "int";
+		decl->name.name = var;
+		decl->val = std::make_unique<Assignment>();
+		decl->val->val = operation(identifier("a"), TokenType::PLUS, operation(identifier(std::to_string(i)), TokenType::MULTIPLY, identifier("b")));
+		func.body.push_back(std::move(decl));
+
+		// v<i> = v<i> * 2 + a
+		func.body.push_back(assignment(var, operation(operation(identifier(var), TokenType::MULTIPLY, identifier("2")), TokenType::PLUS, identifier("a"))));
+
+		// if (v<i> > 10) { v<i> = v<i> - 1 } else { v<i> = v<i> + 1 }
+		std::unique_ptr<IfStatement> branch = std::make_unique<IfStatement>(IfStatement::IfType::IF);
+		branch->condition = operation(identifier(var), TokenType::GREATER_THAN, identifier("10"));
+		branch->body.push_back(assignment(var, operation(identifier(var), TokenType::MINUS, identifier("1"))));
+
+		branch->next = std::make_unique<IfStatement>(IfStatement::IfType::ELSE);
+		branch->next->body.push_back(assignment(var, operation(identifier(var), TokenType::PLUS, identifier("1"))));
+		func.body.push_back(std::move(branch));
+
+		// print("value ", v<i>)
+		std::unique_ptr<FunctionCall> call = std::make_unique<FunctionCall>();
+		call->funcName.name = "print";
+		call->args.push_back(std::make_unique<StringLiteral>("value "));
+		call->args.push_back(identifier(var));
+		func.body.push_back(std::move(call));
+	}
+
+	// return v0 + v7
+	std::unique_ptr<ReturnStatement> ret = std::make_unique<ReturnStatement>();
+	ret->expr = operation(identifier("v0"), TokenType::PLUS, identifier("v7"));
+	func.body.push_back(std::move(ret));
+
+	return func;
+}
+
+// Returns the number of nodes translated for the node (including the node itself)
+static size_t countNodes(const ASTNode* node)
+{
+	if (node == nullptr) { return 0; }
+
+	switch (node->type)
+	{
+		case ASTNode::NodeType::VARIABLE_DECLARATION:
+		{
+			const VariableDeclaration* decl = static_cast<const VariableDeclaration*>(node);
+			return 1 + countNodes(decl->val.get());
+		}
+
+		case ASTNode::NodeType::ASSIGNMENT:
+			return 1 + countNodes(static_cast<const Assignment*>(node)->val.get());
+
+		case ASTNode::NodeType::OPERATION:
+		{
+			const Operation* op = static_cast<const Operation*>(node);
+			return 1 + countNodes(op->lhs.get()) + countNodes(op->rhs.get());
+		}
+
+		case ASTNode::NodeType::FUNCTION_CALL:
+		{
+			size_t count = 1;
+			for (const std::unique_ptr<ASTNode>& arg : static_cast<const FunctionCall*>(node)->args) { count += countNodes(arg.get()); }
+
+			return count;
+		}
+
+		case ASTNode::NodeType::IF_STATEMENT:
+		{
+			size_t count = 0;
+
+			for (const IfStatement* branch = static_cast<const IfStatement*>(node); branch != nullptr; branch = branch->next.get())
+			{
+				count += 1 + countNodes(branch->condition.get());
+				for (const std::unique_ptr<ASTNode>& statement : branch->body) { count += countNodes(statement.get()); }
+			}
+
+			return count;
+		}
+
+		case ASTNode::NodeType::RETURN_STATEMENT:
+			return 1 + countNodes(static_cast<const ReturnStatement*>(node)->expr.get());
+
+		default:
+			return 1;
+	}
+}
+
+// Returns the time taken to translate every statement of the file (in seconds)
+static double measure(FileAST& file)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for (FunctionDeclaration& func : file.functions)
+	{
+		LX::Translator::Translator translator;
+
+		for (std::unique_ptr<ASTNode>& statement : func.body) { translator.assembleNode(statement.get()); }
+	}
+
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	size_t functions = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : DEFAULT_FUNCTIONS;
+
+	FileAST file;
+	file.functions.reserve(functions);
+
+	for (size_t i = 0; i < functions; i++) { file.functions.push_back(generateFunction(i)); }
+
+	size_t nodes = 0;
+
+	for (const FunctionDeclaration& func : file.functions)
+	{
+		for (const std::unique_ptr<ASTNode>& statement : func.body) { nodes += countNodes(statement.get()); }
+	}
+
+	double fastest = measure(file);
+	for (int i = 1; i < RUNS; i++) { fastest = std::min(fastest, measure(file)); }
+
+	std::cout << "Functions:     " << functions << "\n";
+	std::cout << "Nodes:         " << nodes << "\n";
+	std::cout << "Fastest run:   " << fastest * 1000.0 << " ms\n";
+	std::cout << "Time per node: " << fastest * 1e9 / nodes << " ns\n";
+
+	return 0;
+}
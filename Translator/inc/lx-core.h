@@ -49,8 +49,21 @@ namespace LX::Translator
 
 	namespace Core
 	{
+		// Plain function pointer so calling a core function has no std::function overhead
+		typedef void (*CoreFunction)(LX::Parser::FunctionCall*, Translator&);
+
+		// Header of the runtime library used by the core functions (Translator/runtime/lx-runtime.h)
+		// It is copied to the build folder by the compiler
+		constexpr const char* RUNTIME_HEADER = "lx-runtime.h";
+
 		void printFunction(LX::Parser::FunctionCall* call, Translator& assembler);
 
-		extern std::unordered_map <std::string, std::function<void(LX::Parser::FunctionCall*, Translator&)>> funcMap;
+		// Translates a run of print calls (with nothing between them) to a single output operation
+		// Arguments that are literals are joined into a single string literal at compile time
+		void printFunctions(const std::vector<LX::Parser::FunctionCall*>& calls, Translator& assembler);
+
+		void flushFunction(LX::Parser::FunctionCall* call, Translator& assembler);
+
+		extern const std::unordered_map<std::string, CoreFunction> funcMap;
 	};
 }
\ No newline at end of file
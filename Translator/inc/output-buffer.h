@@ -0,0 +1,100 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+namespace LX::Translator
+{
+	// Append only buffer that the translated C++ is written to
+	// The output is kept in chunks so appending never moves what has already been written (unlike std::string)
+	// It also skips the locale and formatting work that std::ostringstream does for every fragment
+	class OutputBuffer
+	{
+		private:
+			// Size of the chunks added once the reserved space has run out
+			static constexpr size_t CHUNK_SIZE = 4096;
+
+			// Each chunk has its capacity reserved when it is created and only the last one is written to
+			std::vector<std::string> chunks;
+
+			// Total size of all the chunks
+			size_t totalSize = 0;
+
+			// Adds a chunk with space for at least the given amount of bytes
+			void newChunk(size_t minimum);
+
+		public:
+			OutputBuffer() = default;
+
+			// Makes sure the given amount of bytes can be appended without any more allocations
+			void reserve(size_t bytes);
+
+			void append(const char* data, size_t length);
+
+			inline OutputBuffer& operator<<(std::string_view str) { append(str.data(), str.size()); return *this; }
+			inline OutputBuffer& operator<<(const std::string& str) { append(str.data(), str.size()); return *this; }
+			inline OutputBuffer& operator<<(const char* str) { append(str, std::strlen(str)); return *this; }
+			inline OutputBuffer& operator<<(char c) { append(&c, 1); return *this; }
+
+			// Integers are written with std::to_chars which does not depend on the locale
+			template<typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>>>
+			inline OutputBuffer& operator<<(T value)
+			{
+				char digits[24];
+				std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+
+				append(digits, result.ptr - digits);
+				return *this;
+			}
+
+			inline size_t size() const { return totalSize; }
+
+			// Moves the contents out as a single string and empties the buffer
+			// If everything fits in one chunk it is moved instead of copied
+			std::string take();
+	};
+
+	/*
+	* @brief Writes all of the parts to the file (replacing what was there) without joining them first
+	* Uses a single writev call on POSIX systems and one buffered fwrite per part on Windows
+	*
+	* @return True if the whole file was written
+	*/
+	bool writeParts(const std::string& path, const std::vector<std::string_view>& parts);
+}
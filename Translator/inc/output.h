@@ -0,0 +1,137 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+#include <translator.h>
+#include <batch-io.h>
+
+namespace LX::Translator
+{
+	// Header included by every translated file so it can be precompiled once per build
+	// It holds all of the standard library headers used by the project
+	constexpr const char* PRELUDE_HEADER = "lx-prelude.h";
+
+	// Folder (within the output directory) of the declaration headers
+	// Each function name gets its own header holding the declarations of all its overloads
+	// Files only include the headers of the functions they call so changing a declaration only recompiles its callers
+	constexpr const char* DECLARATION_DIR = "decl";
+
+	// Returns the path of the declaration header of a function (relative to the output directory)
+	inline std::string declarationHeader(const std::string& funcName)
+	{
+		return std::string(DECLARATION_DIR) + "/" + funcName + ".h";
+	}
+
+	// Source file used by compilers (such as MSVC) that need a .cpp file to create the precompiled header
+	constexpr const char* PRELUDE_SOURCE = "lx-prelude.cpp";
+
+	// File (within the output directory) listing the .cpp files written by the last build, one per line
+	// Only the files in it are ever deleted so any other files in the output directory are left alone
+	constexpr const char* OUTPUT_MANIFEST = "lx-outputs.txt";
+
+	// How the translated functions are split into .cpp files
+	struct OutputOptions
+	{
+		// Unity builds group multiple functions into each .cpp file
+		// This stops the C++ compiler parsing the same headers once per function
+		// A new file is started when adding the next function would go over any of the limits (0 means no limit)
+		// If all of them are 0 every function gets its own file
+
+		// Number of files to split the functions across
+		unsigned int unityUnits = 0;
+
+		// Maximum number of functions in each file
+		unsigned int unityMaxFunctions = 0;
+
+		// Maximum size of the function bodies in each file (in bytes)
+		unsigned int unityMaxBytes = 0;
+
+		inline bool isUnityBuild() const
+		{
+			return unityUnits != 0 || unityMaxFunctions != 0 || unityMaxBytes != 0;
+		}
+	};
+
+	/*
+	* @brief Writes the contents to the file only if they are different to what is already there
+	* Unchanged files keep their modification time so the C++ compiler can skip recompiling them
+	*
+	* @return True if the file was written
+	*/
+	bool writeIfChanged(const std::string& path, const std::string& contents);
+
+	// Same as above but the contents are split into parts that are written without being joined
+	bool writeIfChanged(const std::string& path, const std::vector<std::string_view>& parts);
+
+	// Same as above for multiple files at once
+	// The files that might not have changed are read in one batch and the ones that did are written in another
+	// Returns the number of files that were written
+	size_t writeIfChanged(std::vector<FileWrite>& files);
+
+	// Holds the output of every file that has been translated
+	// Functions are only ever added in declaration order after a file has been translated
+	// This keeps the file names and headers the same no matter which thread translated which function
+	class OutputRegistry
+	{
+		private:
+			std::mutex lock;
+
+			// Number of functions added so far for each .lx file and function name pair
+			// The Nth overload of a function (in declaration order) is written to "<file>_<name>-f<N>.cpp"
+			// The first one has no number so functions without overloads keep their simple file name
+			std::unordered_map<std::string, unsigned int> overloadCounts;
+
+			// Every function added so far
+			std::vector<TranslatedFunction> functions;
+
+		public:
+			OutputRegistry() = default;
+
+			// Gives the functions of a file their .cpp file names and moves them into the registry
+			void add(std::vector<TranslatedFunction>& funcs);
+
+			// Returns the paths of the declaration headers of all the functions added so far (sorted and without duplicates)
+			std::vector<std::string> getDeclarationHeaders();
+
+			// Writes all of the functions to .cpp files in the output directory along with the prelude and declaration headers
+			// Should only be called once all of the files have been translated
+			void write(const std::string& outputDir, const OutputOptions& options);
+	};
+}
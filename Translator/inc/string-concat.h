@@ -0,0 +1,75 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+namespace LX::Translator
+{
+	// Forward declarations
+	class Translator;
+
+	/*
+	* @brief An operation chain in the order it is written to the C++ output
+	* Operations are written without brackets so C++ operator precedence decides how the chain is grouped
+	*/
+	struct FlatOperation
+	{
+		std::vector<LX::Parser::ASTNode*> operands;
+
+		// ops[i] is between operands[i] and operands[i + 1]
+		std::vector<LX::Lexer::TokenType> ops;
+
+		explicit FlatOperation(LX::Parser::Operation* operation);
+
+		// Returns the index of the operand that ends the run of + (or - * / %) that starts at the operand
+		// C++ applies every other operator after these so each run is a single sum in the output
+		size_t endOfSum(size_t start) const;
+
+		// Returns true if the operators from operand start to operand end are all +
+		bool isOnlyPlus(size_t start, size_t end) const;
+	};
+
+	/*
+	* @brief Writes a sum of strings as a single call to lx::concat (Translator/runtime/lx-runtime.h)
+	* lx::concat reserves the length of the result once and appends every piece instead of creating a string for each +
+	*
+	* @return False if the operands are not known to be strings (nothing is written)
+	*/
+	bool assembleConcat(Translator& translator, const FlatOperation& chain, size_t start, size_t end);
+}
@@ -0,0 +1,62 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+#include <common.h>
+
+namespace LX::Translator
+{
+	// Forward declarations
+	class Translator;
+
+	// Return statements that are translated as a jump back to the start of the function
+	typedef std::unordered_set<const LX::Parser::ReturnStatement*> TailCalls;
+
+	/*
+	* @brief Finds the return statements that return a call of the function to itself
+	* The body of the function is put in a loop and these calls assign their arguments to the parameters and continue it
+	* This means recursion of any depth cannot overflow the stack whatever the C++ compiler optimizes
+	* Calls are only included if the arguments are known to have the types of the parameters (so the call cannot be to an overload)
+	*
+	* @note The variable types of the translator need to be known first
+	*/
+	TailCalls findTailCalls(const Translator& translator, LX::Parser::FunctionDeclaration& func);
+
+	// Writes the assignments of a tail call to the parameters of the function being translated
+	void assembleTailCall(Translator& translator, LX::Parser::ReturnStatement* returnStatement);
+}
@@ -44,25 +44,39 @@
 
 namespace LX::Translator
 {
-	void assembleIdentifier(Translator& translator, LX::Parser::ASTNode* node);
+	// Each function takes the node already cast to its type
+	// Translator::assembleNode does the dispatch from the node type
 
-	void assembleVariableDeclaration(Translator& translator, LX::Parser::ASTNode* node);
+	// Returns the C++ type of a variable (and adds the header it needs)
+	std::string variableType(Translator& translator, const LX::Parser::VariableDeclaration* varDecl);
 
-	void assembleAssignment(Translator& translator, LX::Parser::ASTNode* node);
+	void assembleIdentifier(Translator& translator, LX::Parser::Identifier* identifier);
 
-	void assembleOperation(Translator& translator, LX::Parser::ASTNode* node);
+	void assembleVariableDeclaration(Translator& translator, LX::Parser::VariableDeclaration* varDecl);
 
-	void assembleUnaryOperation(Translator& translator, LX::Parser::ASTNode* node);
+	void assembleDestructuringDeclaration(Translator& translator, LX::Parser::DestructuringDeclaration* destructuring);
 
-	void assembleFunctionCall(Translator& translator, LX::Parser::ASTNode* node);
+	void assembleAssignment(Translator& translator, LX::Parser::Assignment* assignment);
 
-	void assembleStringLiteral(Translator& translator, LX::Parser::ASTNode* node);
+	void assembleOperation(Translator& translator, LX::Parser::Operation* operation);
 
-	void assembleBracketedExpression(Translator& translator, LX::Parser::ASTNode* node);
+	void assembleUnaryOperation(Translator& translator, LX::Parser::UnaryOperation* unaryOperation);
 
-	void assembleIfStatement(Translator& translator, LX::Parser::ASTNode* node);
+	void assembleFunctionCall(Translator& translator, LX::Parser::FunctionCall* functionCall);
 
-	void assembleReturnStatement(Translator& translator, LX::Parser::ASTNode* node);
+	void assembleStringLiteral(Translator& translator, LX::Parser::StringLiteral* stringLiteral);
+
+	void assembleBracketedExpression(Translator& translator, LX::Parser::BracketedExpression* bracketedExpression);
+
+	void assembleTupleExpression(Translator& translator, LX::Parser::TupleExpression* tuple);
+
+	void assembleIfStatement(Translator& translator, LX::Parser::IfStatement* ifStatement);
+
+	void assembleLoopStatement(Translator& translator, LX::Parser::LoopStatement* loopStatement);
+
+	void assembleJumpStatement(Translator& translator, LX::Parser::JumpStatement* jumpStatement);
+
+	void assembleReturnStatement(Translator& translator, LX::Parser::ReturnStatement* returnStatement);
 
 	void assembleUndefined(Translator& translator, LX::Parser::ASTNode* node);
 }
\ No newline at end of file
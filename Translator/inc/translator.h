@@ -40,25 +40,81 @@
 
 #include <common.h>
 
+#include <constant-views.h>
+#include <last-use.h>
 #include <lx-core.h>
+#include <output-buffer.h>
+#include <tail-calls.h>
 
 namespace LX::Translator
 {
+	// The C++ output of a single LX function
+	struct TranslatedFunction
+	{
+		// Name of the function and the .lx file it was declared in
+		std::string name;
+		std::string lx_fileName;
+
+		// Declaration of the function (written to its declaration header)
+		std::string header;
+
+		// Standard library headers needed by the declaration of the function
+		std::set<std::string> headerIncludes;
+
+		// Standard library headers needed by the function
+		std::set<std::string> includes;
+
+		// Names of the (non-core) functions called by the function
+		// Only the declaration headers of these are included by its .cpp file
+		std::set<std::string> callees;
+
+		// Body of the .cpp file (without the includes)
+		std::string source;
+
+		// Name of the .cpp file the function is written to when not using a unity build
+		// Given by the OutputRegistry when the function is added
+		std::string fileName;
+	};
+
 	class Translator
 	{
 		public:
-			static std::vector<std::string> funcList;
-			static std::vector<std::string> funcHeaders;
-
 			std::set<std::string> includes;
-			std::ostringstream out;
+			std::set<std::string> callees;
+			OutputBuffer out;
+
+			// Reads of variables that are translated as std::move(name) as the value is not used afterwards
+			MovableUses movableUses;
+
+			// Static const strings that are translated as std::string_view
+			std::unordered_set<std::string> viewableConstants;
+
+			// Type of each variable of the function ("" if there are variables with the same name but different types)
+			std::unordered_map<std::string, std::string> variableTypes;
+
+			// Function being translated
+			LX::Parser::FunctionDeclaration* function = nullptr;
 
-			static std::unordered_map<LX::Parser::ASTNode::NodeType, std::function<void(Translator&, LX::Parser::ASTNode*)>> nodeTranslators;
+			// Number of destructuring declarations translated so far (used to name their temporaries)
+			size_t destructuringCount = 0;
+
+			// Returns of calls to the function itself that are translated as continuing the loop around its body
+			TailCalls tailCalls;
 
 			Translator() = default;
 
 			void assembleNode(LX::Parser::ASTNode* node);
 
-			void assemble(LX::Parser::FunctionDeclaration& AST, const std::string outputDir, const std::string lx_fileName);
+			// Assembles the statements of a function or if statement body
+			// Runs of print calls are combined into a single output operation
+			void assembleBlock(std::vector<std::unique_ptr<LX::Parser::ASTNode>>& body);
+
+			TranslatedFunction assemble(LX::Parser::FunctionDeclaration& AST, const std::string& lx_fileName);
 	};
-}
+
+	// Forward declaration
+	class OutputRegistry;
+
+	// Translates every function of the file on a worker pool and adds them to the registry
+	void translateFile(LX::Parser::FileAST& AST, OutputRegistry& registry, const std::string& lx_fileName);
+}
\ No newline at end of file
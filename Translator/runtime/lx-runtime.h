@@ -0,0 +1,223 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#pragma once
+
+// Runtime library of the translated LX code
+// Copied to the build folder by the compiler and included by the prelude of any project that uses it
+// Only uses the C++17 standard library so it works with every supported C++ compiler
+
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace lx
+{
+	/*
+	* @brief Buffered sink for everything written by print
+	* Text is collected in a large buffer and only written to stdout when it is full, when flush is called or when the program exits
+	* This avoids the flush of std::endl and the synchronization of std::cout with C stdio on every print
+	*/
+	class OutputSink
+	{
+		public:
+			static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+			// Largest number of characters written for a single number
+			static constexpr size_t MAX_NUMBER_SIZE = 32;
+
+			OutputSink() = default;
+
+			// Anything left in the buffer is written when the program exits
+			~OutputSink() { flush(); }
+
+			OutputSink(const OutputSink&) = delete;
+			OutputSink& operator=(const OutputSink&) = delete;
+
+			inline void write(std::string_view text)
+			{
+				// Text bigger than the buffer is written straight to stdout
+				if (text.size() > BUFFER_SIZE - used)
+				{
+					flushBuffer();
+
+					if (text.size() >= BUFFER_SIZE)
+					{
+						std::fwrite(text.data(), 1, text.size(), stdout);
+						return;
+					}
+				}
+
+				text.copy(buffer + used, text.size());
+				used += text.size();
+			}
+
+			inline void write(char c)
+			{
+				if (used == BUFFER_SIZE) { flushBuffer(); }
+
+				buffer[used++] = c;
+			}
+
+			// Writes any value print can take
+			// Numbers are formatted with std::to_chars (floating point numbers the same way as std::cout)
+			template<typename T>
+			inline void writeValue(const T& value)
+			{
+				if constexpr (std::is_same_v<T, bool>)
+				{
+					// Same as std::cout which writes bools as numbers
+					write(value ? '1' : '0');
+				}
+
+				else if constexpr (std::is_same_v<T, char>)
+				{
+					write(value);
+				}
+
+				else if constexpr (std::is_integral_v<T>)
+				{
+					reserveNumber();
+
+					std::to_chars_result result = std::to_chars(buffer + used, buffer + BUFFER_SIZE, value);
+					used = result.ptr - buffer;
+				}
+
+				else if constexpr (std::is_floating_point_v<T>)
+				{
+					reserveNumber();
+
+					// The default format of std::cout is %g (6 significant digits)
+					used += std::snprintf(buffer + used, MAX_NUMBER_SIZE, "%g", static_cast<double>(value));
+				}
+
+				else
+				{
+					static_assert(std::is_convertible_v<const T&, std::string_view>, "print cannot write this type");
+					write(std::string_view(value));
+				}
+			}
+
+			// print is translated to a chain of these the same way it was with std::cout
+			// C++17 runs each operand of the chain (and writes it) before the next one so the output is in the same order
+			template<typename T>
+			inline OutputSink& operator<<(const T& value)
+			{
+				writeValue(value);
+				return *this;
+			}
+
+			// Writes the buffer to stdout and flushes it
+			inline void flush()
+			{
+				flushBuffer();
+				std::fflush(stdout);
+			}
+
+		private:
+			char buffer[BUFFER_SIZE];
+			size_t used = 0;
+
+			inline void flushBuffer()
+			{
+				if (used == 0) { return; }
+
+				std::fwrite(buffer, 1, used, stdout);
+				used = 0;
+			}
+
+			// Makes sure there is space for a number at the end of the buffer
+			inline void reserveNumber()
+			{
+				if (BUFFER_SIZE - used < MAX_NUMBER_SIZE) { flushBuffer(); }
+			}
+	};
+
+	// Returns the sink used by print
+	// It is created on first use so it is destroyed (and flushed) after anything that used it
+	inline OutputSink& output()
+	{
+		static OutputSink sink;
+		return sink;
+	}
+
+	// Writes anything printed so far to stdout
+	inline void flush()
+	{
+		output().flush();
+	}
+
+	/*
+	* @brief Joins the pieces into a single string
+	* A sum of strings is translated to one call to this so the length of the result is reserved once
+	* instead of creating a new string for every +
+	*/
+	template<typename... Pieces>
+	inline std::string concat(const Pieces&... pieces)
+	{
+		const std::string_view views[] = { std::string_view(pieces)... };
+
+		size_t length = 0;
+		for (std::string_view view : views) { length += view.size(); }
+
+		std::string out;
+		out.reserve(length);
+
+		for (std::string_view view : views) { out.append(view); }
+
+		return out;
+	}
+
+	// Used when the first piece is a temporary (or a variable that is not used again) so its memory is reused for the result
+	template<typename... Pieces>
+	inline std::string concat(std::string&& first, const Pieces&... pieces)
+	{
+		const std::string_view views[] = { std::string_view(pieces)... };
+
+		size_t length = first.size();
+		for (std::string_view view : views) { length += view.size(); }
+
+		first.reserve(length);
+
+		for (std::string_view view : views) { first.append(view); }
+
+		return std::move(first);
+	}
+}
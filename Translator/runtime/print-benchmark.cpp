@@ -0,0 +1,95 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+// Compares the lines per second of print lowered to std::cout (with std::endl) and to the buffered runtime
+// Build with optimizations (such as "g++ -O2 -std=c++17 print-benchmark.cpp" or "cl /O2 /std:c++17 /EHsc print-benchmark.cpp")
+// Run with stdout redirected to a file or the null device ("print-benchmark > /dev/null" or "print-benchmark > NUL")
+// The results are written to stderr
+
+#include "lx-runtime.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+// Number of lines printed by each method (can be changed by the first argument)
+static constexpr long long DEFAULT_LINES = 2'000'000;
+
+// What print("line ", i, " of ", lines) used to be translated to
+static void printWithCout(long long lines)
+{
+	for (long long i = 0; i < lines; i++)
+	{
+		std::cout << "line " << i << " of " << lines << std::endl;
+	}
+}
+
+// What print("line ", i, " of ", lines) is translated to now
+static void printWithRuntime(long long lines)
+{
+	for (long long i = 0; i < lines; i++)
+	{
+		lx::output() << "line " << i << " of " << lines << '\n';
+	}
+
+	lx::flush();
+}
+
+// Returns the lines per second of the print method
+template<typename Func>
+static double measure(Func func, long long lines)
+{
+	auto start = std::chrono::steady_clock::now();
+	func(lines);
+	auto end = std::chrono::steady_clock::now();
+
+	return lines / std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	long long lines = argc > 1 ? std::atoll(argv[1]) : DEFAULT_LINES;
+
+	double coutRate = measure(printWithCout, lines);
+	double runtimeRate = measure(printWithRuntime, lines);
+
+	std::cerr << "std::cout + std::endl: " << static_cast<long long>(coutRate) << " lines/s\n";
+	std::cerr << "lx::output():          " << static_cast<long long>(runtimeRate) << " lines/s\n";
+	std::cerr << "Speedup:               " << runtimeRate / coutRate << "x\n";
+
+	return 0;
+}
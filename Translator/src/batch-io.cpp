@@ -0,0 +1,520 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <batch-io.h>
+
+#include <common.h>
+
+#include <output-buffer.h>
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <sys/uio.h>
+	#include <unistd.h>
+	#include <cerrno>
+	#include <climits>
+#endif
+
+// io_uring is used through its system calls so liburing is not needed
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+	#define LX_IO_URING
+	#include <linux/io_uring.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+#endif
+
+namespace LX::Translator
+{
+	// Maximum number of files open at once (and the size of the io_uring queues)
+	// Keeps large projects under the open file limit of the process
+	static constexpr size_t BATCH_SIZE = 256;
+
+	// ---------------- Fallback ---------------- //
+
+	static bool readFile(const std::string& path, std::string& contents)
+	{
+		#ifdef _WIN32
+
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) { return false; }
+
+		contents.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+
+		return static_cast<bool>(file.read(contents.data(), contents.size()));
+
+		#else
+
+		int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file == -1) { return false; }
+
+		struct stat info;
+		if (fstat(file, &info) != 0) { close(file); return false; }
+
+		contents.resize(static_cast<size_t>(info.st_size));
+
+		size_t done = 0;
+		while (done < contents.size())
+		{
+			ssize_t count = read(file, contents.data() + done, contents.size() - done);
+
+			if (count < 0 && errno == EINTR) { continue; }
+
+			// A failed read would otherwise look like a shorter file
+			if (count < 0) { close(file); return false; }
+			if (count == 0) { break; }
+
+			done += static_cast<size_t>(count);
+		}
+
+		// The file might have shrunk since it was checked
+		contents.resize(done);
+
+		close(file);
+		return true;
+
+		#endif
+	}
+
+	static void readFilesThreaded(std::vector<FileRead>& files, size_t start)
+	{
+		LX::Thread::parallelFor(files.size() - start, [&](size_t i)
+		{
+			FileRead& file = files[start + i];
+			file.success = readFile(file.path, file.contents);
+		});
+	}
+
+	static void writeFilesThreaded(std::vector<FileWrite>& files, size_t start)
+	{
+		LX::Thread::parallelFor(files.size() - start, [&](size_t i)
+		{
+			FileWrite& file = files[start + i];
+			file.success = writeParts(file.path, file.parts);
+		});
+	}
+
+	// ---------------- io_uring ---------------- //
+
+	#ifdef LX_IO_URING
+
+	// Minimal io_uring wrapper (only what is needed for batches of reads and writes)
+	class Ring
+	{
+		private:
+			int ringFile = -1;
+
+			// Submission queue
+			unsigned* sqHead = nullptr;
+			unsigned* sqTail = nullptr;
+			unsigned* sqMask = nullptr;
+			unsigned* sqArray = nullptr;
+			io_uring_sqe* sqes = nullptr;
+
+			// Completion queue
+			unsigned* cqHead = nullptr;
+			unsigned* cqTail = nullptr;
+			unsigned* cqMask = nullptr;
+			io_uring_cqe* cqes = nullptr;
+
+			// Memory shared with the kernel
+			void* sqRing = MAP_FAILED;
+			void* cqRing = MAP_FAILED;
+			size_t sqRingSize = 0;
+			size_t cqRingSize = 0;
+			size_t sqesSize = 0;
+
+			// Entries added since the last submit
+			unsigned pending = 0;
+
+		public:
+			unsigned entries = 0;
+
+			Ring() = default;
+
+			Ring(const Ring&) = delete;
+			Ring& operator=(const Ring&) = delete;
+
+			~Ring()
+			{
+				destroy();
+			}
+
+			// Unmaps the queues and closes the ring
+			// The kernel cancels any operations that are still in flight when the ring is closed
+			void destroy()
+			{
+				if (sqes != nullptr) { munmap(sqes, sqesSize); }
+				if (cqRing != MAP_FAILED && cqRing != sqRing) { munmap(cqRing, cqRingSize); }
+				if (sqRing != MAP_FAILED) { munmap(sqRing, sqRingSize); }
+				if (ringFile != -1) { close(ringFile); }
+
+				sqes = nullptr;
+				sqRing = cqRing = MAP_FAILED;
+				ringFile = -1;
+			}
+
+			// Returns false if io_uring is not supported (or not allowed) by the system
+			bool init(unsigned depth)
+			{
+				io_uring_params params;
+				std::memset(&params, 0, sizeof(params));
+
+				ringFile = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+				if (ringFile < 0) { ringFile = -1; return false; }
+
+				entries = params.sq_entries;
+
+				sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+				cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+				sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+				// Newer kernels map both rings with a single call
+				bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+				if (singleMap) { sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize); }
+
+				sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFile, IORING_OFF_SQ_RING);
+				if (sqRing == MAP_FAILED) { return false; }
+
+				cqRing = singleMap ? sqRing : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFile, IORING_OFF_CQ_RING);
+				if (cqRing == MAP_FAILED) { return false; }
+
+				void* sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFile, IORING_OFF_SQES);
+				if (sqesMap == MAP_FAILED) { return false; }
+				sqes = static_cast<io_uring_sqe*>(sqesMap);
+
+				char* sq = static_cast<char*>(sqRing);
+				sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+				sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+				sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+				sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+				char* cq = static_cast<char*>(cqRing);
+				cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+				cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+				cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+				cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+				return true;
+			}
+
+			// Adds a readv or writev to the submission queue (the iovecs must stay valid until it completes)
+			void queue(unsigned char opcode, int file, const iovec* vecs, unsigned count, unsigned long long offset, unsigned long long userData)
+			{
+				unsigned tail = *sqTail;
+				unsigned index = tail & *sqMask;
+
+				io_uring_sqe& sqe = sqes[index];
+				std::memset(&sqe, 0, sizeof(sqe));
+
+				sqe.opcode = opcode;
+				sqe.fd = file;
+				sqe.addr = reinterpret_cast<unsigned long long>(vecs);
+				sqe.len = count;
+				sqe.off = offset;
+				sqe.user_data = userData;
+
+				sqArray[index] = index;
+
+				// The kernel must see the entry before it sees the new tail
+				__atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+				pending++;
+			}
+
+			// Submits everything that has been queued and waits for at least one completion
+			bool submitAndWait()
+			{
+				while (true)
+				{
+					long result = syscall(__NR_io_uring_enter, ringFile, pending, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+					if (result >= 0) { pending -= static_cast<unsigned>(result); return true; }
+					if (errno != EINTR) { return false; }
+				}
+			}
+
+			// Waits for at least one completion without submitting anything
+			bool wait()
+			{
+				while (true)
+				{
+					long result = syscall(__NR_io_uring_enter, ringFile, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+
+					if (result >= 0) { return true; }
+					if (errno != EINTR) { return false; }
+				}
+			}
+
+			// Number of queued entries that have not been submitted to the kernel yet
+			inline unsigned unsubmitted() const { return pending; }
+
+			// Calls the function with the user data and result of every finished operation
+			template<typename Func>
+			void reap(Func&& func)
+			{
+				unsigned head = *cqHead;
+				unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+
+				while (head != tail)
+				{
+					const io_uring_cqe& cqe = cqes[head & *cqMask];
+					func(cqe.user_data, cqe.res);
+					head++;
+				}
+
+				__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+			}
+	};
+
+	// A file that is part of the current batch
+	struct RingFile
+	{
+		int file = -1;
+
+		// Part of the file that still needs to be read or written
+		std::vector<iovec> vecs;
+		size_t firstVec = 0;
+
+		// Bytes read or written so far
+		size_t done = 0;
+	};
+
+	// Moves the iovecs past the bytes that have been read or written
+	static void advance(RingFile& ringFile, size_t count)
+	{
+		ringFile.done += count;
+
+		while (ringFile.firstVec < ringFile.vecs.size() && count >= ringFile.vecs[ringFile.firstVec].iov_len)
+		{
+			count -= ringFile.vecs[ringFile.firstVec].iov_len;
+			ringFile.firstVec++;
+		}
+
+		if (ringFile.firstVec < ringFile.vecs.size())
+		{
+			iovec& vec = ringFile.vecs[ringFile.firstVec];
+			vec.iov_base = static_cast<char*>(vec.iov_base) + count;
+			vec.iov_len -= count;
+		}
+	}
+
+	/*
+	* @brief Keeps submitting the unfinished files until all of them are done
+	* onComplete is called with the index of each file and whether it succeeded
+	*
+	* @return False if io_uring stopped working (the unfinished files are left for the fallback)
+	*/
+	template<typename Func>
+	static bool runBatch(Ring& ring, unsigned char opcode, std::vector<RingFile>& batch, Func&& onComplete)
+	{
+		std::vector<size_t> waiting;
+		for (size_t i = 0; i < batch.size(); i++)
+		{
+			if (batch[i].firstVec < batch[i].vecs.size()) { waiting.push_back(i); }
+			else { onComplete(i, true); }
+		}
+
+		size_t inFlight = 0;
+
+		while (!waiting.empty() || inFlight != 0)
+		{
+			// Fills the submission queue
+			while (!waiting.empty() && inFlight < ring.entries)
+			{
+				size_t index = waiting.back();
+				waiting.pop_back();
+
+				RingFile& ringFile = batch[index];
+				unsigned count = static_cast<unsigned>(std::min<size_t>(ringFile.vecs.size() - ringFile.firstVec, IOV_MAX));
+
+				ring.queue(opcode, ringFile.file, ringFile.vecs.data() + ringFile.firstVec, count, ringFile.done, index);
+				inFlight++;
+			}
+
+			if (!ring.submitAndWait())
+			{
+				// Operations that were already submitted still use the buffers and files the fallback is about to use
+				// So they are waited for (without handling their results as the fallback does the files again)
+				size_t submitted = inFlight - ring.unsubmitted();
+				auto discard = [&](unsigned long long, int) { submitted--; };
+
+				ring.reap(discard);
+				while (submitted != 0 && ring.wait()) { ring.reap(discard); }
+
+				// If they cannot be waited for closing the ring cancels them
+				if (submitted != 0) { ring.destroy(); }
+
+				return false;
+			}
+
+			ring.reap([&](unsigned long long index, int result)
+			{
+				inFlight--;
+				RingFile& ringFile = batch[index];
+
+				// Interrupted operations are tried again
+				if (result == -EINTR || result == -EAGAIN) { waiting.push_back(index); return; }
+
+				// Reading nothing means the file has shrunk since it was checked
+				if (result <= 0) { onComplete(index, result == 0 && opcode == IORING_OP_READV); return; }
+
+				advance(ringFile, static_cast<size_t>(result));
+
+				// Short reads and writes continue from where they stopped
+				if (ringFile.firstVec < ringFile.vecs.size()) { waiting.push_back(index); }
+				else { onComplete(index, true); }
+			});
+		}
+
+		return true;
+	}
+
+	// Returns how many of the files were handled (the rest are left for the fallback)
+	static size_t readFilesRing(std::vector<FileRead>& files)
+	{
+		Ring ring;
+		if (!ring.init(BATCH_SIZE)) { return 0; }
+
+		for (size_t start = 0; start < files.size(); start += BATCH_SIZE)
+		{
+			size_t end = std::min(files.size(), start + BATCH_SIZE);
+			std::vector<RingFile> batch(end - start);
+
+			// Opens the files and makes space for their contents
+			for (size_t i = 0; i < batch.size(); i++)
+			{
+				FileRead& file = files[start + i];
+				RingFile& ringFile = batch[i];
+
+				ringFile.file = open(file.path.c_str(), O_RDONLY | O_CLOEXEC);
+				if (ringFile.file == -1) { continue; }
+
+				struct stat info;
+				if (fstat(ringFile.file, &info) != 0) { close(ringFile.file); ringFile.file = -1; continue; }
+
+				file.contents.resize(static_cast<size_t>(info.st_size));
+				if (!file.contents.empty()) { ringFile.vecs.push_back({ file.contents.data(), file.contents.size() }); }
+			}
+
+			bool ringWorks = runBatch(ring, IORING_OP_READV, batch, [&](size_t i, bool success)
+			{
+				FileRead& file = files[start + i];
+
+				file.success = success && batch[i].file != -1;
+				file.contents.resize(batch[i].done);
+			});
+
+			for (RingFile& ringFile : batch)
+			{
+				if (ringFile.file != -1) { close(ringFile.file); }
+			}
+
+			if (!ringWorks) { return start; }
+		}
+
+		return files.size();
+	}
+
+	static size_t writeFilesRing(std::vector<FileWrite>& files)
+	{
+		Ring ring;
+		if (!ring.init(BATCH_SIZE)) { return 0; }
+
+		for (size_t start = 0; start < files.size(); start += BATCH_SIZE)
+		{
+			size_t end = std::min(files.size(), start + BATCH_SIZE);
+			std::vector<RingFile> batch(end - start);
+
+			for (size_t i = 0; i < batch.size(); i++)
+			{
+				FileWrite& file = files[start + i];
+				RingFile& ringFile = batch[i];
+
+				ringFile.file = open(file.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+				if (ringFile.file == -1) { continue; }
+
+				ringFile.vecs.reserve(file.parts.size());
+
+				for (std::string_view part : file.parts)
+				{
+					if (!part.empty()) { ringFile.vecs.push_back({ const_cast<char*>(part.data()), part.size() }); }
+				}
+			}
+
+			bool ringWorks = runBatch(ring, IORING_OP_WRITEV, batch, [&](size_t i, bool success)
+			{
+				files[start + i].success = success && batch[i].file != -1;
+			});
+
+			for (size_t i = 0; i < batch.size(); i++)
+			{
+				if (batch[i].file != -1 && close(batch[i].file) != 0) { files[start + i].success = false; }
+			}
+
+			if (!ringWorks) { return start; }
+		}
+
+		return files.size();
+	}
+
+	#endif
+
+	// ---------------- Public functions ---------------- //
+
+	void readFiles(std::vector<FileRead>& files)
+	{
+		size_t done = 0;
+
+		#ifdef LX_IO_URING
+		done = readFilesRing(files);
+		#endif
+
+		if (done < files.size()) { readFilesThreaded(files, done); }
+	}
+
+	void writeFiles(std::vector<FileWrite>& files)
+	{
+		size_t done = 0;
+
+		#ifdef LX_IO_URING
+		done = writeFilesRing(files);
+		#endif
+
+		if (done < files.size()) { writeFilesThreaded(files, done); }
+	}
+}
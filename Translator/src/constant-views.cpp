@@ -0,0 +1,265 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <constant-views.h>
+
+#include <common.h>
+
+#include <lx-core.h>
+#include <string-concat.h>
+
+namespace LX::Translator
+{
+	using LX::Parser::ASTNode;
+	using LX::Lexer::TokenType;
+
+	// Operators that take a std::string_view (or a std::string) on either side
+	static bool isComparison(TokenType op)
+	{
+		switch (op)
+		{
+			case TokenType::EQUALS:
+			case TokenType::NOT_EQUALS:
+			case TokenType::LESS_THAN:
+			case TokenType::LESS_THAN_EQUALS:
+			case TokenType::GREATER_THAN:
+			case TokenType::GREATER_THAN_EQUALS:
+				return true;
+
+			default:
+				return false;
+		}
+	}
+
+	// Removes the variables that are used somewhere a std::string_view cannot be
+	// canView is true if the node is used somewhere a std::string_view can be
+	static void removeUnviewable(ASTNode* node, bool canView, std::unordered_set<std::string>& names)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr || names.empty()) { return; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+				if (canView == false) { names.erase(static_cast<Identifier*>(node)->name); }
+				return;
+
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+			{
+				VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(node);
+
+				// The declaration of a viewable constant is translated with the value as it is
+				if (varDecl->val != nullptr) { removeUnviewable(varDecl->val->val.get(), false, names); }
+				return;
+			}
+
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+				removeUnviewable(static_cast<DestructuringDeclaration*>(node)->val.get(), false, names);
+				return;
+
+			case ASTNode::NodeType::ASSIGNMENT:
+				removeUnviewable(static_cast<Assignment*>(node)->val.get(), false, names);
+				return;
+
+			// Operands of comparisons and the pieces of lx::concat can be views
+			case ASTNode::NodeType::OPERATION:
+			{
+				FlatOperation chain(static_cast<Operation*>(node));
+
+				for (size_t i = 0; i < chain.operands.size(); i++)
+				{
+					bool isCompared = (i > 0 && isComparison(chain.ops[i - 1])) || (i < chain.ops.size() && isComparison(chain.ops[i]));
+
+					size_t start = i;
+					while (start > 0 && chain.ops[start - 1] == TokenType::PLUS) { start--; }
+
+					bool isJoined = chain.endOfSum(start) != start && chain.isOnlyPlus(start, chain.endOfSum(start));
+
+					removeUnviewable(chain.operands[i], isCompared || isJoined, names);
+				}
+
+				return;
+			}
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+				removeUnviewable(static_cast<UnaryOperation*>(node)->val.get(), false, names);
+				return;
+
+			// Core functions (such as print) take any string
+			case ASTNode::NodeType::FUNCTION_CALL:
+			{
+				FunctionCall* call = static_cast<FunctionCall*>(node);
+				bool isCore = Core::funcMap.find(call->funcName.name) != Core::funcMap.end();
+
+				for (std::unique_ptr<ASTNode>& arg : call->args)
+				{
+					removeUnviewable(arg.get(), isCore, names);
+				}
+
+				return;
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				removeUnviewable(static_cast<BracketedExpression*>(node)->expr.get(), canView, names);
+				return;
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+				for (std::unique_ptr<ASTNode>& value : static_cast<TupleExpression*>(node)->values)
+				{
+					removeUnviewable(value.get(), false, names);
+				}
+
+				return;
+
+			case ASTNode::NodeType::IF_STATEMENT:
+				for (IfStatement* branch = static_cast<IfStatement*>(node); branch != nullptr; branch = branch->next.get())
+				{
+					removeUnviewable(branch->condition.get(), false, names);
+
+					for (std::unique_ptr<ASTNode>& statement : branch->body)
+					{
+						removeUnviewable(statement.get(), false, names);
+					}
+				}
+
+				return;
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+			{
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(node);
+
+				removeUnviewable(loopStatement->init.get(), false, names);
+				removeUnviewable(loopStatement->condition.get(), false, names);
+				removeUnviewable(loopStatement->step.get(), false, names);
+
+				for (std::unique_ptr<ASTNode>& statement : loopStatement->body)
+				{
+					removeUnviewable(statement.get(), false, names);
+				}
+
+				return;
+			}
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+				removeUnviewable(static_cast<ReturnStatement*>(node)->expr.get(), false, names);
+				return;
+
+			default:
+				return;
+		}
+	}
+
+	// Adds the static const string variables declared in the block with a string literal as their value
+	static void findConstants(LX::Parser::AST& body, std::unordered_map<std::string, size_t>& declarations, std::unordered_set<std::string>& names)
+	{
+		using namespace LX::Parser;
+
+		for (std::unique_ptr<ASTNode>& statement : body)
+		{
+			if (statement == nullptr) { continue; }
+
+			if (statement->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+			{
+				VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(statement.get());
+				declarations[varDecl->name.name]++;
+
+				bool isLiteral = varDecl->val != nullptr && varDecl->val->val != nullptr && varDecl->val->val->type == ASTNode::NodeType::STRING_LITERAL;
+
+				if (isLiteral && varDecl->varType.name == "string" && varDecl->isStatic() && varDecl->isConst() && varDecl->isReference() == false)
+				{
+					names.insert(varDecl->name.name);
+				}
+			}
+
+			else if (statement->type == ASTNode::NodeType::DESTRUCTURING_DECLARATION)
+			{
+				for (std::unique_ptr<VariableDeclaration>& var : static_cast<DestructuringDeclaration*>(statement.get())->vars)
+				{
+					declarations[var->name.name]++;
+				}
+			}
+
+			else if (statement->type == ASTNode::NodeType::IF_STATEMENT)
+			{
+				for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+				{
+					findConstants(branch->body, declarations, names);
+				}
+			}
+
+			// A variable declared by the init of a loop is counted so it hides the constant like any other declaration
+			else if (statement->type == ASTNode::NodeType::LOOP_STATEMENT)
+			{
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(statement.get());
+
+				if (loopStatement->init != nullptr && loopStatement->init->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+				{
+					declarations[static_cast<VariableDeclaration*>(loopStatement->init.get())->name.name]++;
+				}
+
+				findConstants(loopStatement->body, declarations, names);
+			}
+		}
+	}
+
+	std::unordered_set<std::string> findViewableConstants(LX::Parser::FunctionDeclaration& func)
+	{
+		std::unordered_map<std::string, size_t> declarations;
+		std::unordered_set<std::string> names;
+
+		for (std::unique_ptr<LX::Parser::ASTNode>& arg : func.args)
+		{
+			declarations[static_cast<LX::Parser::VariableDeclaration*>(arg.get())->name.name]++;
+		}
+
+		findConstants(func.body, declarations, names);
+
+		// Uses are found by name so variables that hide another variable are left as they are
+		for (const auto& [name, count] : declarations)
+		{
+			if (count != 1) { names.erase(name); }
+		}
+
+		for (std::unique_ptr<LX::Parser::ASTNode>& statement : func.body)
+		{
+			removeUnviewable(statement.get(), false, names);
+		}
+
+		return names;
+	}
+}
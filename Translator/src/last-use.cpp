@@ -0,0 +1,538 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <last-use.h>
+
+#include <common.h>
+
+#include <lx-core.h>
+#include <string-concat.h>
+
+namespace LX::Translator
+{
+	using LX::Parser::ASTNode;
+
+	// Variable names that are live (will be read before being written to)
+	typedef std::unordered_set<std::string> LiveSet;
+
+	// Calls func for the node and every expression below it (does not go into the bodies of if statements)
+	static void forEachExpression(ASTNode* node, const std::function<void(ASTNode*)>& func)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return; }
+
+		func(node);
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+				forEachExpression(static_cast<VariableDeclaration*>(node)->val.get(), func);
+				return;
+
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+				forEachExpression(static_cast<DestructuringDeclaration*>(node)->val.get(), func);
+				return;
+
+			case ASTNode::NodeType::ASSIGNMENT:
+				forEachExpression(static_cast<Assignment*>(node)->val.get(), func);
+				return;
+
+			case ASTNode::NodeType::OPERATION:
+				forEachExpression(static_cast<Operation*>(node)->lhs.get(), func);
+				forEachExpression(static_cast<Operation*>(node)->rhs.get(), func);
+				return;
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+				forEachExpression(static_cast<UnaryOperation*>(node)->val.get(), func);
+				return;
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+				for (std::unique_ptr<ASTNode>& arg : static_cast<FunctionCall*>(node)->args)
+				{
+					forEachExpression(arg.get(), func);
+				}
+
+				return;
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				forEachExpression(static_cast<BracketedExpression*>(node)->expr.get(), func);
+				return;
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+				for (std::unique_ptr<ASTNode>& value : static_cast<TupleExpression*>(node)->values)
+				{
+					forEachExpression(value.get(), func);
+				}
+
+				return;
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+				forEachExpression(static_cast<ReturnStatement*>(node)->expr.get(), func);
+				return;
+
+			default:
+				return;
+		}
+	}
+
+	// Adds every variable read by the statements (and the blocks within them) to the set
+	static void addReads(LX::Parser::AST& body, LiveSet& live)
+	{
+		using namespace LX::Parser;
+
+		auto addExpression = [&](ASTNode* node)
+		{
+			forEachExpression(node, [&](ASTNode* child)
+			{
+				if (child->type == ASTNode::NodeType::IDENTIFIER) { live.insert(static_cast<Identifier*>(child)->name); }
+			});
+		};
+
+		for (std::unique_ptr<ASTNode>& statement : body)
+		{
+			if (statement == nullptr) { continue; }
+
+			if (statement->type == ASTNode::NodeType::IF_STATEMENT)
+			{
+				for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+				{
+					addExpression(branch->condition.get());
+					addReads(branch->body, live);
+				}
+			}
+
+			else if (statement->type == ASTNode::NodeType::LOOP_STATEMENT)
+			{
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(statement.get());
+
+				addExpression(loopStatement->init.get());
+				addExpression(loopStatement->condition.get());
+				addExpression(loopStatement->step.get());
+				addReads(loopStatement->body, live);
+			}
+
+			else
+			{
+				addExpression(statement.get());
+			}
+		}
+	}
+
+	// Removes every variable declared by the statements (and the blocks within them) from the set
+	static void removeDeclared(LX::Parser::AST& body, LiveSet& live)
+	{
+		using namespace LX::Parser;
+
+		for (std::unique_ptr<ASTNode>& statement : body)
+		{
+			if (statement == nullptr) { continue; }
+
+			if (statement->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+			{
+				live.erase(static_cast<VariableDeclaration*>(statement.get())->name.name);
+			}
+
+			else if (statement->type == ASTNode::NodeType::DESTRUCTURING_DECLARATION)
+			{
+				for (std::unique_ptr<VariableDeclaration>& var : static_cast<DestructuringDeclaration*>(statement.get())->vars)
+				{
+					live.erase(var->name.name);
+				}
+			}
+
+			else if (statement->type == ASTNode::NodeType::IF_STATEMENT)
+			{
+				for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+				{
+					removeDeclared(branch->body, live);
+				}
+			}
+
+			else if (statement->type == ASTNode::NodeType::LOOP_STATEMENT)
+			{
+				removeDeclared(static_cast<LoopStatement*>(statement.get())->body, live);
+			}
+		}
+	}
+
+	class LastUseAnalysis
+	{
+		private:
+			// String variables that own their value
+			std::unordered_set<std::string> movable;
+
+			// Variables declared by a destructuring declaration
+			// C++ does not move these when they are returned so they are moved by the translator
+			std::unordered_set<std::string> bindings;
+
+			// Returns the node as a variable if it can be moved from (or nullptr)
+			const LX::Parser::Identifier* asMovable(ASTNode* node) const
+			{
+				if (node == nullptr || node->type != ASTNode::NodeType::IDENTIFIER) { return nullptr; }
+
+				const LX::Parser::Identifier* var = static_cast<const LX::Parser::Identifier*>(node);
+
+				return movable.find(var->name) != movable.end() ? var : nullptr;
+			}
+
+			// Checks the statements of a block working backwards from the end
+			// Returns the variables that are live at the start of the block
+			LiveSet analyseBlock(LX::Parser::AST& body, LiveSet live);
+
+			// Checks a statement that is not an if statement or a loop
+			void analyseStatement(ASTNode* statement, LiveSet& live);
+
+			// Checks a loop (returns the variables that are live before it)
+			LiveSet analyseLoop(LX::Parser::LoopStatement* loopStatement, const LiveSet& live);
+
+			// Variables that are live at the start and the end of each loop around the current statement (innermost last)
+			std::vector<LiveSet> loopLive;
+
+		public:
+			MovableUses uses;
+
+			bool hasMovable() const { return movable.empty() == false; }
+
+			// Finds the variables that can be moved from
+			void findMovable(LX::Parser::FunctionDeclaration& func);
+
+			void analyse(LX::Parser::FunctionDeclaration& func) { analyseBlock(func.body, LiveSet()); }
+	};
+
+	void LastUseAnalysis::findMovable(LX::Parser::FunctionDeclaration& func)
+	{
+		using namespace LX::Parser;
+
+		// Number of times each name is declared
+		// Liveness is tracked by name so variables that hide another variable are left as they are
+		std::unordered_map<std::string, size_t> declarations;
+
+		// Names that are referred to by a reference (or are references)
+		std::unordered_set<std::string> aliased;
+
+		auto declare = [&](VariableDeclaration* varDecl)
+		{
+			declarations[varDecl->name.name]++;
+
+			// Static variables keep their value for the next call so are never moved from
+			if (varDecl->varType.name == "string" && varDecl->isConst() == false && varDecl->isReference() == false && varDecl->isStatic() == false)
+			{
+				movable.insert(varDecl->name.name);
+			}
+
+			if (varDecl->isReference())
+			{
+				aliased.insert(varDecl->name.name);
+
+				if (varDecl->val != nullptr && varDecl->val->val != nullptr && varDecl->val->val->type == ASTNode::NodeType::IDENTIFIER)
+				{
+					aliased.insert(static_cast<Identifier*>(varDecl->val->val.get())->name);
+				}
+			}
+		};
+
+		for (std::unique_ptr<ASTNode>& arg : func.args)
+		{
+			declare(static_cast<VariableDeclaration*>(arg.get()));
+		}
+
+		std::function<void(AST&)> declareBlock = [&](AST& body)
+		{
+			for (std::unique_ptr<ASTNode>& statement : body)
+			{
+				if (statement == nullptr) { continue; }
+
+				if (statement->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+				{
+					declare(static_cast<VariableDeclaration*>(statement.get()));
+				}
+
+				else if (statement->type == ASTNode::NodeType::DESTRUCTURING_DECLARATION)
+				{
+					for (std::unique_ptr<VariableDeclaration>& var : static_cast<DestructuringDeclaration*>(statement.get())->vars)
+					{
+						declare(var.get());
+						bindings.insert(var->name.name);
+					}
+				}
+
+				else if (statement->type == ASTNode::NodeType::IF_STATEMENT)
+				{
+					for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+					{
+						declareBlock(branch->body);
+					}
+				}
+
+				else if (statement->type == ASTNode::NodeType::LOOP_STATEMENT)
+				{
+					LoopStatement* loopStatement = static_cast<LoopStatement*>(statement.get());
+
+					if (loopStatement->init != nullptr && loopStatement->init->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+					{
+						declare(static_cast<VariableDeclaration*>(loopStatement->init.get()));
+					}
+
+					declareBlock(loopStatement->body);
+				}
+			}
+		};
+
+		declareBlock(func.body);
+
+		for (const auto& [name, count] : declarations)
+		{
+			if (count != 1 || aliased.find(name) != aliased.end()) { movable.erase(name); }
+		}
+	}
+
+	void LastUseAnalysis::analyseStatement(ASTNode* statement, LiveSet& live)
+	{
+		using namespace LX::Parser;
+
+		// Variable written to by the statement
+		const std::string* written = nullptr;
+
+		// The value being assigned (or a returned variable that is not moved by C++)
+		ASTNode* value = nullptr;
+
+		if (statement->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+		{
+			VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(statement);
+
+			written = &varDecl->name.name;
+			value = varDecl->val != nullptr ? varDecl->val->val.get() : nullptr;
+		}
+
+		else if (statement->type == ASTNode::NodeType::ASSIGNMENT)
+		{
+			written = &static_cast<Assignment*>(statement)->name.name;
+			value = static_cast<Assignment*>(statement)->val.get();
+		}
+
+		// None of the variables hold a value before the statement
+		else if (statement->type == ASTNode::NodeType::DESTRUCTURING_DECLARATION)
+		{
+			for (std::unique_ptr<VariableDeclaration>& var : static_cast<DestructuringDeclaration*>(statement)->vars)
+			{
+				live.erase(var->name.name);
+			}
+		}
+
+		// Nothing after a return is run
+		else if (statement->type == ASTNode::NodeType::RETURN_STATEMENT)
+		{
+			live.clear();
+
+			ASTNode* returned = static_cast<ReturnStatement*>(statement)->expr.get();
+
+			if (const Identifier* var = asMovable(returned); var != nullptr && bindings.find(var->name) != bindings.end())
+			{
+				value = returned;
+			}
+		}
+
+		// Number of times each variable is read by the statement
+		// A variable read more than once cannot be moved as the order the reads happen in is not always defined
+		std::unordered_map<std::string, size_t> reads;
+
+		// Reads that copy the variable
+		std::vector<const Identifier*> copies;
+
+		forEachExpression(statement, [&](ASTNode* node)
+		{
+			if (node->type == ASTNode::NodeType::IDENTIFIER)
+			{
+				reads[static_cast<Identifier*>(node)->name]++;
+			}
+
+			// The first string of a sum can be appended to instead of copied
+			else if (node->type == ASTNode::NodeType::OPERATION)
+			{
+				FlatOperation chain(static_cast<Operation*>(node));
+
+				for (size_t start = 0; start < chain.operands.size(); start = chain.endOfSum(start) + 1)
+				{
+					size_t end = chain.endOfSum(start);
+
+					if (end == start || chain.isOnlyPlus(start, end) == false) { continue; }
+
+					if (const Identifier* var = asMovable(chain.operands[start]); var != nullptr) { copies.push_back(var); }
+				}
+			}
+
+			// Each value of a tuple is copied into the returned pair or tuple
+			else if (node->type == ASTNode::NodeType::TUPLE_EXPRESSION)
+			{
+				for (std::unique_ptr<ASTNode>& tupleValue : static_cast<TupleExpression*>(node)->values)
+				{
+					if (const Identifier* var = asMovable(tupleValue.get()); var != nullptr) { copies.push_back(var); }
+				}
+			}
+
+			// Core functions (such as print) only read their arguments
+			else if (node->type == ASTNode::NodeType::FUNCTION_CALL)
+			{
+				FunctionCall* call = static_cast<FunctionCall*>(node);
+
+				if (Core::funcMap.find(call->funcName.name) != Core::funcMap.end()) { return; }
+
+				for (std::unique_ptr<ASTNode>& arg : call->args)
+				{
+					if (const Identifier* var = asMovable(arg.get()); var != nullptr) { copies.push_back(var); }
+				}
+			}
+		});
+
+		// Moving a variable into itself would leave it empty
+		if (const Identifier* var = asMovable(value); var != nullptr && (written == nullptr || var->name != *written))
+		{
+			copies.push_back(var);
+		}
+
+		// The old value is not needed after the statement if the statement overwrites it
+		if (written != nullptr) { live.erase(*written); }
+
+		for (const Identifier* var : copies)
+		{
+			if (reads[var->name] == 1 && live.find(var->name) == live.end())
+			{
+				uses.insert(var);
+			}
+		}
+
+		for (const auto& [name, count] : reads)
+		{
+			live.insert(name);
+		}
+	}
+
+	LiveSet LastUseAnalysis::analyseBlock(LX::Parser::AST& body, LiveSet live)
+	{
+		using namespace LX::Parser;
+
+		// Loops are checked as a whole by analyseLoop so the statements of a block are always run in order
+		for (size_t i = body.size(); i-- > 0;)
+		{
+			ASTNode* statement = body[i].get();
+
+			if (statement == nullptr) { continue; }
+
+			if (statement->type == ASTNode::NodeType::LOOP_STATEMENT)
+			{
+				live = analyseLoop(static_cast<LoopStatement*>(statement), live);
+				continue;
+			}
+
+			// A break or continue goes to the end or the start of the loop
+			if (statement->type == ASTNode::NodeType::JUMP_STATEMENT)
+			{
+				live.insert(loopLive.back().begin(), loopLive.back().end());
+				continue;
+			}
+
+			if (statement->type != ASTNode::NodeType::IF_STATEMENT)
+			{
+				analyseStatement(statement, live);
+				continue;
+			}
+
+			// Live at the start of the if statement is anything live at the start of any branch or read by any condition
+			LiveSet liveBefore;
+			bool hasElse = false;
+
+			for (IfStatement* branch = static_cast<IfStatement*>(statement); branch != nullptr; branch = branch->next.get())
+			{
+				liveBefore.merge(analyseBlock(branch->body, live));
+
+				forEachExpression(branch->condition.get(), [&](ASTNode* node)
+				{
+					if (node->type == ASTNode::NodeType::IDENTIFIER) { liveBefore.insert(static_cast<Identifier*>(node)->name); }
+				});
+
+				hasElse = hasElse || branch->type == IfStatement::IfType::ELSE;
+			}
+
+			// Without an else none of the branches might be run
+			if (hasElse == false) { liveBefore.insert(live.begin(), live.end()); }
+
+			live = std::move(liveBefore);
+		}
+
+		return live;
+	}
+
+	LiveSet LastUseAnalysis::analyseLoop(LX::Parser::LoopStatement* loopStatement, const LiveSet& live)
+	{
+		// The body can be run again after any of its statements so anything read in the loop is live for all of it
+		// Variables declared in the body are created again by each run so are not live at the end of it
+		LiveSet liveInLoop = live;
+		addReads(loopStatement->body, liveInLoop);
+		removeDeclared(loopStatement->body, liveInLoop);
+
+		// The condition and step are run between the runs of the body
+		for (ASTNode* part : { loopStatement->init.get(), loopStatement->condition.get(), loopStatement->step.get() })
+		{
+			forEachExpression(part, [&](ASTNode* node)
+			{
+				if (node->type == ASTNode::NodeType::IDENTIFIER) { liveInLoop.insert(static_cast<LX::Parser::Identifier*>(node)->name); }
+			});
+		}
+
+		loopLive.push_back(liveInLoop);
+		LiveSet liveBefore = analyseBlock(loopStatement->body, liveInLoop);
+		loopLive.pop_back();
+
+		liveBefore.insert(liveInLoop.begin(), liveInLoop.end());
+		return liveBefore;
+	}
+
+	MovableUses findMovableUses(LX::Parser::FunctionDeclaration& func)
+	{
+		LastUseAnalysis analysis;
+		analysis.findMovable(func);
+
+		// Nothing to do for functions without string variables
+		if (analysis.hasMovable())
+		{
+			analysis.analyse(func);
+		}
+
+		return std::move(analysis.uses);
+	}
+}
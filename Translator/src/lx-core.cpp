@@ -44,24 +44,162 @@
 
 namespace LX::Translator
 {
+	// Prints to the buffered output of the runtime instead of std::cout
+	// It is only written to stdout when the buffer is full, when flush is called or when the program exits
 	void Core::printFunction(LX::Parser::FunctionCall* call, Translator& translator)
 	{
-		translator.includes.insert("iostream");
-		translator.out << "std::cout";
+		printFunctions({ call }, translator);
+	}
+
+	static bool isHexDigit(char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
+	static bool isOctalDigit(char c) { return c >= '0' && c <= '7'; }
+
+	// How the text of a string literal ends
+	enum class LiteralEnd : char
+	{
+		PLAIN,
+		HEX_ESCAPE, // Would take any hex digits after it
+		OCTAL_ESCAPE, // Would take any octal digits after it (up to three)
+		BACKSLASH // Not a valid literal on its own
+	};
+
+	static LiteralEnd literalEnd(const std::string& text)
+	{
+		LiteralEnd end = LiteralEnd::PLAIN;
+		size_t i = 0;
 
-		for (std::unique_ptr<LX::Parser::ASTNode>& arg : call->args)
+		while (i < text.size())
 		{
-			translator.out << " << ";
-			translator.assembleNode(arg.get());
+			end = LiteralEnd::PLAIN;
+
+			if (text[i] != '\\') { i++; continue; }
+
+			if (i + 1 == text.size()) { return LiteralEnd::BACKSLASH; }
+
+			char type = text[i + 1];
+			i += 2;
+
+			if (type == 'x')
+			{
+				while (i < text.size() && isHexDigit(text[i])) { i++; }
+				end = LiteralEnd::HEX_ESCAPE;
+			}
+
+			else if (isOctalDigit(type))
+			{
+				size_t length = 1;
+				while (i < text.size() && length < 3 && isOctalDigit(text[i])) { i++; length++; }
+				end = length < 3 ? LiteralEnd::OCTAL_ESCAPE : LiteralEnd::PLAIN;
+			}
 		}
 
-		translator.out << " << std::endl;\n";
+		return end;
+	}
+
+	// Gets the text printed for an argument if it is known at compile time
+	// The text is written the same way as in a C++ string literal
+	static bool constantText(LX::Parser::ASTNode* arg, std::string& text)
+	{
+		if (arg->type == LX::Parser::ASTNode::NodeType::STRING_LITERAL)
+		{
+			text = static_cast<LX::Parser::StringLiteral*>(arg)->value;
+			return literalEnd(text) != LiteralEnd::BACKSLASH;
+		}
+
+		if (arg->type != LX::Parser::ASTNode::NodeType::IDENTIFIER) { return false; }
+
+		const std::string& name = static_cast<LX::Parser::Identifier*>(arg)->name;
+
+		// Bools are printed as numbers
+		if (name == "true") { text = "1"; return true; }
+		if (name == "false") { text = "0"; return true; }
+
+		// Integer literals are printed as they are written unless they have leading zeros (octal)
+		size_t start = (name.size() > 1 && name[0] == '-') ? 1 : 0;
+		size_t digits = name.size() - start;
+
+		if (digits == 0 || digits > 18 || (name[start] == '0' && digits != 1)) { return false; }
+
+		for (size_t i = start; i < name.size(); i++)
+		{
+			if (name[i] < '0' || name[i] > '9') { return false; }
+		}
+
+		text = name;
+		return true;
+	}
+
+	// Adds text to the end of a string literal
+	// Escape sequences at the end of the literal would continue into the text so it is split into two literals that C++ joins
+	static void appendText(std::string& literal, const std::string& text)
+	{
+		if (text.empty()) { return; }
+
+		LiteralEnd end = literalEnd(literal);
+
+		if ((end == LiteralEnd::HEX_ESCAPE && isHexDigit(text[0])) || (end == LiteralEnd::OCTAL_ESCAPE && isOctalDigit(text[0])))
+		{
+			literal.append("\" \"");
+		}
+
+		literal.append(text);
+	}
+
+	void Core::printFunctions(const std::vector<LX::Parser::FunctionCall*>& calls, Translator& translator)
+	{
+		translator.includes.insert(RUNTIME_HEADER);
+		translator.out << "lx::output()";
+
+		// Text that is known at compile time and has not been written yet
+		std::string literal;
+		std::string text;
+
+		auto writeLiteral = [&]()
+		{
+			if (literal.empty()) { return; }
+
+			// A single character is cheaper to write than a string
+			if (literal == "\\n") { translator.out << " << '\\n'"; }
+			else { translator.out << " << \"" << literal << "\""; }
+
+			literal.clear();
+		};
+
+		for (LX::Parser::FunctionCall* call : calls)
+		{
+			for (std::unique_ptr<LX::Parser::ASTNode>& arg : call->args)
+			{
+				if (constantText(arg.get(), text))
+				{
+					appendText(literal, text);
+					continue;
+				}
+
+				writeLiteral();
+
+				translator.out << " << ";
+				translator.assembleNode(arg.get());
+			}
+
+			appendText(literal, "\\n");
+		}
+
+		writeLiteral();
+
+		translator.out << ";\n";
+	}
+
+	void Core::flushFunction(LX::Parser::FunctionCall*, Translator& translator)
+	{
+		translator.includes.insert(RUNTIME_HEADER);
+		translator.out << "lx::flush()";
 	}
 
 	// Core function map
 
-	std::unordered_map <std::string, std::function<void(LX::Parser::FunctionCall*, Translator&)>> Core::funcMap =
+	const std::unordered_map<std::string, Core::CoreFunction> Core::funcMap =
 	{
-		{"print", printFunction}
+		{"print", printFunction},
+		{"flush", flushFunction}
 	};
 }
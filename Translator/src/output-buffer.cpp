@@ -0,0 +1,182 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <output-buffer.h>
+
+#include <common.h>
+
+#ifdef _WIN32
+	#include <cstdio>
+#else
+	#include <fcntl.h>
+	#include <sys/uio.h>
+	#include <unistd.h>
+	#include <climits>
+#endif
+
+namespace LX::Translator
+{
+	void OutputBuffer::newChunk(size_t minimum)
+	{
+		chunks.emplace_back();
+		chunks.back().reserve(std::max(minimum, CHUNK_SIZE));
+	}
+
+	void OutputBuffer::reserve(size_t bytes)
+	{
+		// Only needs a new chunk if the current one does not have enough space left
+		if (chunks.empty() || chunks.back().capacity() - chunks.back().size() < bytes)
+		{
+			newChunk(bytes);
+		}
+	}
+
+	void OutputBuffer::append(const char* data, size_t length)
+	{
+		totalSize += length;
+
+		while (length != 0)
+		{
+			if (chunks.empty() || chunks.back().size() == chunks.back().capacity())
+			{
+				newChunk(length);
+			}
+
+			// Fills the current chunk without going over its capacity (which would reallocate it)
+			std::string& chunk = chunks.back();
+			size_t count = std::min(length, chunk.capacity() - chunk.size());
+
+			chunk.append(data, count);
+
+			data += count;
+			length -= count;
+		}
+	}
+
+	std::string OutputBuffer::take()
+	{
+		std::string result;
+
+		if (chunks.size() == 1)
+		{
+			result = std::move(chunks[0]);
+		}
+
+		else
+		{
+			result.reserve(totalSize);
+			for (const std::string& chunk : chunks) { result.append(chunk); }
+		}
+
+		chunks.clear();
+		totalSize = 0;
+
+		return result;
+	}
+
+	#ifdef _WIN32
+
+	bool writeParts(const std::string& path, const std::vector<std::string_view>& parts)
+	{
+		FILE* file = std::fopen(path.c_str(), "wb");
+		if (file == nullptr) { return false; }
+
+		// Buffers the whole file so the parts are written in as few system calls as possible
+		size_t total = 0;
+		for (std::string_view part : parts) { total += part.size(); }
+		std::setvbuf(file, nullptr, _IOFBF, std::max<size_t>(total, BUFSIZ));
+
+		bool success = true;
+		for (std::string_view part : parts)
+		{
+			success = success && std::fwrite(part.data(), 1, part.size(), file) == part.size();
+		}
+
+		return (std::fclose(file) == 0) && success;
+	}
+
+	#else
+
+	bool writeParts(const std::string& path, const std::vector<std::string_view>& parts)
+	{
+		int file = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (file == -1) { return false; }
+
+		std::vector<iovec> vecs;
+		vecs.reserve(parts.size());
+
+		for (std::string_view part : parts)
+		{
+			if (!part.empty()) { vecs.push_back({ const_cast<char*>(part.data()), part.size() }); }
+		}
+
+		// writev can write less than asked for (or be limited to IOV_MAX parts) so it is called until everything is written
+		size_t index = 0;
+		bool success = true;
+
+		while (index < vecs.size())
+		{
+			int count = static_cast<int>(std::min<size_t>(vecs.size() - index, IOV_MAX));
+			ssize_t written = writev(file, vecs.data() + index, count);
+
+			if (written < 0)
+			{
+				if (errno == EINTR) { continue; }
+
+				success = false;
+				break;
+			}
+
+			// Skips the parts that were fully written and moves the start of the partly written one
+			while (index < vecs.size() && static_cast<size_t>(written) >= vecs[index].iov_len)
+			{
+				written -= vecs[index].iov_len;
+				index++;
+			}
+
+			if (index < vecs.size())
+			{
+				vecs[index].iov_base = static_cast<char*>(vecs[index].iov_base) + written;
+				vecs[index].iov_len -= written;
+			}
+		}
+
+		return (close(file) == 0) && success;
+	}
+
+	#endif
+}
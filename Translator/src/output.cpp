@@ -0,0 +1,442 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <output.h>
+
+#include <common.h>
+
+#include <translator.h>
+#include <output-buffer.h>
+#include <batch-io.h>
+
+namespace LX::Translator
+{
+	bool writeIfChanged(const std::string& path, const std::string& contents)
+	{
+		return writeIfChanged(path, std::vector<std::string_view>{ contents });
+	}
+
+	bool writeIfChanged(const std::string& path, const std::vector<std::string_view>& parts)
+	{
+		std::vector<FileWrite> files = { { path, parts } };
+
+		return writeIfChanged(files) != 0;
+	}
+
+	size_t writeIfChanged(std::vector<FileWrite>& files)
+	{
+		// Files of a different size must have changed so only the ones with the same size are read
+		std::vector<FileRead> existing;
+		std::vector<size_t> existingIndices;
+
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			size_t size = 0;
+			for (std::string_view part : files[i].parts) { size += part.size(); }
+
+			std::error_code ec;
+			if (std::filesystem::file_size(files[i].path, ec) == size && !ec)
+			{
+				existing.push_back({ files[i].path, {}, false });
+				existingIndices.push_back(i);
+			}
+		}
+
+		readFiles(existing);
+
+		std::vector<bool> unchanged(files.size(), false);
+
+		for (size_t i = 0; i < existing.size(); i++)
+		{
+			if (!existing[i].success) { continue; }
+
+			// Compares each part against the same section of the file
+			std::string_view onDisk = existing[i].contents;
+			size_t offset = 0;
+			bool same = true;
+
+			for (std::string_view part : files[existingIndices[i]].parts)
+			{
+				if (onDisk.substr(offset, part.size()) != part) { same = false; break; }
+				offset += part.size();
+			}
+
+			unchanged[existingIndices[i]] = same && offset == onDisk.size();
+		}
+
+		// Writes the files that changed in one batch
+		std::vector<FileWrite> changed;
+
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			if (!unchanged[i]) { changed.push_back(std::move(files[i])); }
+		}
+
+		writeFiles(changed);
+
+		for (const FileWrite& file : changed)
+		{
+			if (!file.success) { THROW_ERROR("Failed to write to " + file.path); }
+		}
+
+		return changed.size();
+	}
+
+	void OutputRegistry::add(std::vector<TranslatedFunction>& funcs)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		for (TranslatedFunction& func : funcs)
+		{
+			// Creates the start of the function .cpp filename
+			func.fileName.reserve(func.lx_fileName.size() + func.name.size() + 16);
+			func.fileName.append(func.lx_fileName).append("_").append(func.name).append("-f");
+
+			// Gets how many functions with the same name came before this one (meaning it is an overloaded function)
+			// '/' cannot be part of a file or function name so the key is unique to the pair
+			unsigned int& count = overloadCounts[func.lx_fileName + '/' + func.name];
+
+			// Overloads have their index added to the end of the file name
+			if (count != 0) { func.fileName.append(std::to_string(count)); }
+			count++;
+
+			func.fileName.append(".cpp");
+
+			functions.push_back(std::move(func));
+		}
+	}
+
+	std::vector<std::string> OutputRegistry::getDeclarationHeaders()
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		std::set<std::string> names;
+		for (const TranslatedFunction& func : functions) { names.insert(func.name); }
+
+		std::vector<std::string> headers;
+		headers.reserve(names.size());
+
+		for (const std::string& name : names)
+		{
+			headers.push_back(declarationHeader(name));
+		}
+
+		return headers;
+	}
+
+	// A .cpp file and the functions that are written to it
+	struct OutputFile
+	{
+		std::string fileName;
+		std::vector<const TranslatedFunction*> functions;
+	};
+
+	// Every overload of each function name (in declaration order)
+	// std::map is used so the headers are always written in the same order
+	typedef std::map<std::string, std::vector<const TranslatedFunction*>> OverloadSet;
+
+	// Groups the functions into unity files
+	// Functions keep their declaration order so the same project always produces the same files
+	static std::vector<OutputFile> groupUnityFiles(const std::vector<TranslatedFunction>& functions, const OutputOptions& options)
+	{
+		size_t maxFunctions = options.unityMaxFunctions;
+
+		// A set number of files is the same as a function limit that spreads them evenly
+		if (options.unityUnits != 0)
+		{
+			size_t perUnit = (functions.size() + options.unityUnits - 1) / options.unityUnits;
+			maxFunctions = (maxFunctions == 0) ? perUnit : std::min(maxFunctions, perUnit);
+		}
+
+		std::vector<OutputFile> files;
+		size_t currentBytes = 0;
+
+		for (const TranslatedFunction& func : functions)
+		{
+			bool full = files.empty();
+
+			if (!full)
+			{
+				const OutputFile& current = files.back();
+
+				full = (maxFunctions != 0 && current.functions.size() >= maxFunctions) ||
+					(options.unityMaxBytes != 0 && currentBytes + func.source.size() > options.unityMaxBytes);
+			}
+
+			// A file always gets at least one function even if it is bigger than the byte limit
+			if (full)
+			{
+				files.push_back({ "lx_unity_" + std::to_string(files.size()) + ".cpp", {} });
+				currentBytes = 0;
+			}
+
+			files.back().functions.push_back(&func);
+			currentBytes += func.source.size();
+		}
+
+		return files;
+	}
+
+	// Returns the includes at the top of a .cpp file (the function sources come after them)
+	static std::string fileIncludes(const OutputFile& outFile, const OverloadSet& overloads)
+	{
+		// Gets the functions called by the file
+		// Calls to functions that do not exist are left for the C++ compiler to report
+		std::set<std::string> callees;
+		for (const TranslatedFunction* func : outFile.functions)
+		{
+			for (const std::string& callee : func->callees)
+			{
+				if (overloads.find(callee) != overloads.end()) { callees.insert(callee); }
+			}
+		}
+
+		OutputBuffer includes;
+
+		// The prelude must be the first thing in the file for MSVC to use the precompiled version of it
+		includes << "#include <" << PRELUDE_HEADER << ">\n\n";
+
+		// Only the declarations of the functions that are called are included
+		for (const std::string& callee : callees) { includes << "#include <" << declarationHeader(callee) << ">\n"; }
+		if (!callees.empty()) { includes << '\n'; }
+
+		return includes.take();
+	}
+
+	static std::string preludeHeader(const std::vector<TranslatedFunction>& functions)
+	{
+		// Combines the includes of all the functions
+		std::set<std::string> includes;
+		for (const TranslatedFunction& func : functions) { includes.insert(func.includes.begin(), func.includes.end()); }
+
+		std::string header = "#pragma once\n\n";
+		for (const std::string& include : includes) { header.append("#include <").append(include).append(">\n"); }
+
+		return header;
+	}
+
+	static std::string declarationHeaderContents(const std::vector<const TranslatedFunction*>& overloads)
+	{
+		// Combines the includes needed by the declarations of all the overloads
+		std::set<std::string> includes;
+		for (const TranslatedFunction* func : overloads) { includes.insert(func->headerIncludes.begin(), func->headerIncludes.end()); }
+
+		std::string header = "#pragma once\n\n";
+
+		for (const std::string& include : includes) { header.append("#include <").append(include).append(">\n"); }
+		if (!includes.empty()) { header.append("\n"); }
+
+		for (const TranslatedFunction* func : overloads) { header.append(func->header).append(";\n"); }
+
+		return header;
+	}
+
+	// Checks if the file name is one that could have been given to a translated file
+	// Only used when there is no manifest (such as output directories from before it existed)
+	static bool isGeneratedName(const std::string& fileName)
+	{
+		if (fileName.size() < 4 || fileName.compare(fileName.size() - 4, 4, ".cpp") != 0) { return false; }
+		std::string stem = fileName.substr(0, fileName.size() - 4);
+
+		// Unity files are "lx_unity_<N>.cpp"
+		constexpr std::string_view unity = "lx_unity_";
+		if (stem.size() > unity.size() && stem.compare(0, unity.size(), unity) == 0)
+		{
+			return stem.find_first_not_of("0123456789", unity.size()) == std::string::npos;
+		}
+
+		// Function files are "<file>_<func>-f<N>.cpp" where the number is optional
+		size_t end = stem.find_last_not_of("0123456789");
+		return end != std::string::npos && end >= 2 && stem[end] == 'f' && stem[end - 1] == '-' && stem.find('_') < end - 1;
+	}
+
+	// Removes .cpp files (and thier object files) left over from previous builds
+	// Without this functions that were deleted, or a change to/from a unity build, would cause duplicate symbols
+	// Returns the contents of the new manifest listing the files of this build
+	static std::string removeStaleFiles(const std::vector<OutputFile>& files, const std::string& outputDir)
+	{
+		std::set<std::string> current;
+		for (const OutputFile& file : files) { current.insert(file.fileName); }
+
+		std::vector<FileRead> manifest = { { outputDir + "/" + OUTPUT_MANIFEST, {}, false } };
+		readFiles(manifest);
+
+		// The files written by the previous build
+		std::vector<std::string> previous;
+		std::error_code ec;
+
+		if (manifest[0].success)
+		{
+			std::string_view contents = manifest[0].contents;
+
+			while (!contents.empty())
+			{
+				size_t end = contents.find('\n');
+				std::string_view line = contents.substr(0, end);
+
+				// Entries are only ever plain file names so anything else is ignored
+				if (!line.empty() && line.find_first_of("/\\") == std::string_view::npos && line != "." && line != "..")
+				{
+					previous.emplace_back(line);
+				}
+
+				contents.remove_prefix(end == std::string_view::npos ? contents.size() : end + 1);
+			}
+		}
+
+		else
+		{
+			// Without a manifest only the files with the names the translator gives are removed
+			for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(outputDir, ec))
+			{
+				std::string fileName = entry.path().filename().string();
+				if (entry.is_regular_file(ec) && isGeneratedName(fileName)) { previous.push_back(fileName); }
+			}
+		}
+
+		for (const std::string& fileName : previous)
+		{
+			if (current.find(fileName) != current.end()) { continue; }
+
+			std::filesystem::path path = outputDir + "/" + fileName;
+			std::filesystem::remove(path, ec);
+
+			// MSVC and GCC/Clang object files
+			std::filesystem::remove(path.replace_extension(".obj"), ec);
+			std::filesystem::remove(path.replace_extension(".o"), ec);
+		}
+
+		std::string contents;
+		for (const std::string& fileName : current) { contents.append(fileName).append("\n"); }
+
+		return contents;
+	}
+
+	// Removes the declaration headers of functions that no longer exist
+	static void removeStaleDeclarations(const OverloadSet& overloads, const std::string& outputDir)
+	{
+		std::error_code ec;
+
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(outputDir + "/" + DECLARATION_DIR, ec))
+		{
+			const std::filesystem::path& path = entry.path();
+
+			if (entry.is_regular_file(ec) && path.extension() == ".h" && overloads.find(path.stem().string()) == overloads.end())
+			{
+				std::filesystem::remove(path, ec);
+			}
+		}
+	}
+
+	void OutputRegistry::write(const std::string& outputDir, const OutputOptions& options)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		std::vector<OutputFile> files;
+
+		if (options.isUnityBuild())
+		{
+			files = groupUnityFiles(functions, options);
+		}
+
+		else
+		{
+			// Every function gets its own file
+			files.reserve(functions.size());
+
+			for (const TranslatedFunction& func : functions)
+			{
+				files.push_back({ func.fileName, { &func } });
+			}
+		}
+
+		OverloadSet overloads;
+		for (const TranslatedFunction& func : functions) { overloads[func.name].push_back(&func); }
+
+		// The manifest is written before the files so any that are written are known about by the next build even if this one fails
+		writeIfChanged(outputDir + "/" + OUTPUT_MANIFEST, removeStaleFiles(files, outputDir));
+		removeStaleDeclarations(overloads, outputDir);
+
+		std::error_code ec;
+		std::filesystem::create_directories(outputDir + "/" + DECLARATION_DIR, ec);
+
+		std::vector<OverloadSet::const_iterator> names;
+		names.reserve(overloads.size());
+		for (OverloadSet::const_iterator it = overloads.begin(); it != overloads.end(); it++) { names.push_back(it); }
+
+		// Creates everything that is not already in the registry before writing so all the files can be written in one batch
+		// [0] is the prelude header, [1] the prelude source, then the declaration headers, then the includes of each .cpp file
+		std::vector<std::string> generated(2 + names.size() + files.size());
+		generated[0] = preludeHeader(functions);
+		generated[1] = std::string("#include <") + PRELUDE_HEADER + ">\n";
+
+		LX::Thread::parallelFor(names.size(), [&](size_t i)
+		{
+			generated[2 + i] = declarationHeaderContents(names[i]->second);
+		});
+
+		LX::Thread::parallelFor(files.size(), [&](size_t i)
+		{
+			generated[2 + names.size() + i] = fileIncludes(files[i], overloads);
+		});
+
+		std::vector<FileWrite> writes;
+		writes.reserve(generated.size());
+
+		writes.push_back({ outputDir + "/" + PRELUDE_HEADER, { generated[0] } });
+		writes.push_back({ outputDir + "/" + PRELUDE_SOURCE, { generated[1] } });
+
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			writes.push_back({ outputDir + "/" + declarationHeader(names[i]->first), { generated[2 + i] } });
+		}
+
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			FileWrite& write = writes.emplace_back();
+			write.path = outputDir + "/" + files[i].fileName;
+
+			// The function sources are written straight from the registry instead of being copied into one string
+			write.parts.reserve(1 + files[i].functions.size());
+			write.parts.emplace_back(generated[2 + names.size() + i]);
+
+			for (const TranslatedFunction* func : files[i].functions) { write.parts.emplace_back(func->source); }
+		}
+
+		writeIfChanged(writes);
+	}
+}
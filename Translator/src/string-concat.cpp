@@ -0,0 +1,233 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <string-concat.h>
+
+#include <common.h>
+
+#include <lx-core.h>
+#include <translator.h>
+
+namespace LX::Translator
+{
+	using LX::Lexer::TokenType;
+
+	// Operators with a higher precedence than (or the same as) + in C++
+	static bool isArithmetic(TokenType op)
+	{
+		switch (op)
+		{
+			case TokenType::PLUS:
+			case TokenType::MINUS:
+			case TokenType::MULTIPLY:
+			case TokenType::DIVIDE:
+			case TokenType::MODULO:
+				return true;
+
+			default:
+				return false;
+		}
+	}
+
+	// Adds the operands and operators of the chain in the order they are written
+	static void flattenInto(LX::Parser::ASTNode* node, FlatOperation& out)
+	{
+		if (node == nullptr || node->type != LX::Parser::ASTNode::NodeType::OPERATION)
+		{
+			out.operands.push_back(node);
+			return;
+		}
+
+		LX::Parser::Operation* operation = static_cast<LX::Parser::Operation*>(node);
+
+		flattenInto(operation->lhs.get(), out);
+		out.ops.push_back(operation->op);
+		flattenInto(operation->rhs.get(), out);
+	}
+
+	FlatOperation::FlatOperation(LX::Parser::Operation* operation)
+	{
+		flattenInto(operation, *this);
+	}
+
+	size_t FlatOperation::endOfSum(size_t start) const
+	{
+		size_t end = start;
+
+		while (end < ops.size() && isArithmetic(ops[end])) { end++; }
+
+		return end;
+	}
+
+	bool FlatOperation::isOnlyPlus(size_t start, size_t end) const
+	{
+		for (size_t i = start; i < end; i++)
+		{
+			if (ops[i] != TokenType::PLUS) { return false; }
+		}
+
+		return true;
+	}
+
+	// What is known about the type of an operand
+	enum class OperandType
+	{
+		STRING,
+		NUMBER,
+		UNKNOWN
+	};
+
+	static OperandType typeOf(const Translator& translator, LX::Parser::ASTNode* node)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return OperandType::UNKNOWN; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::STRING_LITERAL:
+				return OperandType::STRING;
+
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				const std::string& name = static_cast<Identifier*>(node)->name;
+
+				// Number literals are stored as identifiers
+				if (name.empty() == false && name[0] >= '0' && name[0] <= '9') { return OperandType::NUMBER; }
+
+				if (auto it = translator.variableTypes.find(name); it != translator.variableTypes.end())
+				{
+					if (it->second == "string") { return OperandType::STRING; }
+
+					// Any other type (int, i8 to i64 or f32 and f64) is a number
+					if (it->second.empty() == false) { return OperandType::NUMBER; }
+				}
+
+				return OperandType::UNKNOWN;
+			}
+
+			// A bracketed sum of strings is a string
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+			{
+				ASTNode* expr = static_cast<BracketedExpression*>(node)->expr.get();
+
+				if (expr == nullptr || expr->type != ASTNode::NodeType::OPERATION) { return typeOf(translator, expr); }
+
+				FlatOperation chain(static_cast<Operation*>(expr));
+
+				if (chain.endOfSum(0) != chain.ops.size() || chain.isOnlyPlus(0, chain.ops.size()) == false) { return OperandType::UNKNOWN; }
+
+				OperandType type = OperandType::UNKNOWN;
+
+				for (ASTNode* operand : chain.operands)
+				{
+					OperandType operandType = typeOf(translator, operand);
+
+					if (operandType == OperandType::NUMBER) { return OperandType::NUMBER; }
+					if (operandType == OperandType::STRING) { type = OperandType::STRING; }
+				}
+
+				return type;
+			}
+
+			default:
+				return OperandType::UNKNOWN;
+		}
+	}
+
+	// Adds the pieces of the sum to the list (including the pieces of any bracketed sums of strings)
+	static void collectPieces(const Translator& translator, const FlatOperation& chain, size_t start, size_t end, std::vector<LX::Parser::ASTNode*>& pieces)
+	{
+		using namespace LX::Parser;
+
+		for (size_t i = start; i <= end; i++)
+		{
+			ASTNode* operand = chain.operands[i];
+
+			if (operand != nullptr && operand->type == ASTNode::NodeType::BRACKETED_EXPRESSION && typeOf(translator, operand) == OperandType::STRING)
+			{
+				ASTNode* expr = static_cast<BracketedExpression*>(operand)->expr.get();
+
+				if (expr->type == ASTNode::NodeType::OPERATION)
+				{
+					FlatOperation inner(static_cast<Operation*>(expr));
+					collectPieces(translator, inner, 0, inner.operands.size() - 1, pieces);
+					continue;
+				}
+			}
+
+			pieces.push_back(operand);
+		}
+	}
+
+	bool assembleConcat(Translator& translator, const FlatOperation& chain, size_t start, size_t end)
+	{
+		// A single operand is not a sum
+		if (end == start || chain.isOnlyPlus(start, end) == false) { return false; }
+
+		// At least one operand has to be a string and none can be numbers
+		bool hasString = false;
+
+		for (size_t i = start; i <= end; i++)
+		{
+			OperandType type = typeOf(translator, chain.operands[i]);
+
+			if (type == OperandType::NUMBER) { return false; }
+
+			hasString = hasString || type == OperandType::STRING;
+		}
+
+		if (hasString == false) { return false; }
+
+		std::vector<LX::Parser::ASTNode*> pieces;
+		collectPieces(translator, chain, start, end, pieces);
+
+		translator.includes.insert(Core::RUNTIME_HEADER);
+		translator.out << "lx::concat(";
+
+		for (size_t i = 0; i < pieces.size(); i++)
+		{
+			if (i != 0) { translator.out << ", "; }
+
+			translator.assembleNode(pieces[i]);
+		}
+
+		translator.out << ")";
+
+		return true;
+	}
+}
@@ -0,0 +1,321 @@
+// ======================================================================================= //
+//                                                                                         //
+// This code is license under a Proprietary License for LX - Compiler                      //
+//                                                                                         //
+// Copyright(c) 2024 Pasha Bibko                                                           //
+//                                                                                         //
+// 1. License Grant                                                                        //
+//     You are granted a non - exclusive, non - transferable, and revocable                //
+//     license to use this software for personal, educational, non - commercial,           //
+//     or internal commercial purposes.You may install and use the software on             //
+//     your devices or within your company, but you may not sell, sublicense,              //
+//     or distribute the software in any form, either directly or as part                  //
+//     of any derivative works. You may privately modify the software for                  //
+//     internal use within your organization, provided that the modified versions          //
+//     are not distributed, shared, or otherwise made available to third parties.          //
+//                                                                                         //
+// 2. Freedom to Share Creations                                                           //
+//     You are free to create, modify, and share works or creations made with this         //
+//     software, provided that you do not redistribute the original software itself.       //
+//     All creations made with this software are solely your responsibility, and           //
+//     you may license or distribute them as you wish, under your own terms.               //
+//                                                                                         //
+// 3. Restrictions                                                                         //
+//     You may not:                                                                        //
+//     - Sell, rent, lease, or distribute the original software or any copies              //
+//       thereof, including modified versions.                                             //
+//     - Distribute the software or modified versions to any third party.                  //
+//                                                                                         //
+// 4. Disclaimer of Warranty                                                               //
+//     This software is provided "as is", without warranty of any kind, either             //
+//     express or implied, including but not limited to the warranties of merchantability, //
+//     fitness for a particular purpose, or non - infringement.In no event shall the       //
+//     authors or copyright holders be liable for any claim, damages, or other liability,  //
+//     whether in an action of contract, tort, or otherwise, arising from, out of, or in   //
+//     connection with the software or the use or other dealings in the software.          //
+//                                                                                         //
+
+#include <tail-calls.h>
+
+#include <common.h>
+
+#include <string-concat.h>
+#include <translate-ast.h>
+#include <translator.h>
+
+namespace LX::Translator
+{
+	using LX::Lexer::TokenType;
+
+	// Returns the variable a node refers to (brackets around a variable still refer to the variable)
+	static const LX::Parser::Identifier* variableOf(const LX::Parser::ASTNode* node)
+	{
+		using namespace LX::Parser;
+
+		while (node != nullptr && node->type == ASTNode::NodeType::BRACKETED_EXPRESSION)
+		{
+			node = static_cast<const BracketedExpression*>(node)->expr.get();
+		}
+
+		if (node == nullptr || node->type != ASTNode::NodeType::IDENTIFIER) { return nullptr; }
+
+		return static_cast<const Identifier*>(node);
+	}
+
+	// Returns true if the argument is the parameter itself (so the parameter does not change)
+	static bool isSameParameter(const LX::Parser::ASTNode* arg, const LX::Parser::VariableDeclaration* param)
+	{
+		const LX::Parser::Identifier* var = variableOf(arg);
+
+		return var != nullptr && var->name == param->name.name;
+	}
+
+	// Returns the LX type of an argument ("" if it is not known)
+	// Only types that cannot be converted to anything else by C++ are given so the call always picks the same function
+	static std::string argumentType(const Translator& translator, LX::Parser::ASTNode* node)
+	{
+		using namespace LX::Parser;
+
+		if (node == nullptr) { return ""; }
+
+		switch (node->type)
+		{
+			case ASTNode::NodeType::STRING_LITERAL:
+				return "string";
+
+			case ASTNode::NodeType::IDENTIFIER:
+			{
+				const std::string& name = static_cast<Identifier*>(node)->name;
+
+				// Number literals are stored as identifiers (only ones that fit in an int have the type int)
+				size_t start = (name.size() > 1 && name[0] == '-') ? 1 : 0;
+
+				if (name.empty() == false && name[start] >= '0' && name[start] <= '9')
+				{
+					bool isInt = name.size() - start <= 9 && std::all_of(name.begin() + start, name.end(), [](char c) { return c >= '0' && c <= '9'; });
+
+					return isInt ? "int" : "";
+				}
+
+				auto it = translator.variableTypes.find(name);
+
+				return it != translator.variableTypes.end() ? it->second : "";
+			}
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				return argumentType(translator, static_cast<BracketedExpression*>(node)->expr.get());
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+			{
+				UnaryOperation* unary = static_cast<UnaryOperation*>(node);
+
+				if (unary->side != UnaryOperation::Sided::LEFT || unary->op != TokenType::MINUS) { return ""; }
+
+				return argumentType(translator, unary->val.get()) == "int" ? "int" : "";
+			}
+
+			// Arithmetic on ints is an int and a sum with a string is a string
+			// Smaller integer types are promoted to int by C++ so operations on them are never given a type
+			case ASTNode::NodeType::OPERATION:
+			{
+				FlatOperation chain(static_cast<Operation*>(node));
+
+				if (chain.endOfSum(0) != chain.ops.size()) { return ""; }
+
+				bool isString = false;
+				bool isInt = true;
+
+				for (ASTNode* operand : chain.operands)
+				{
+					std::string type = argumentType(translator, operand);
+
+					isString = isString || type == "string";
+					isInt = isInt && type == "int";
+				}
+
+				if (isInt) { return "int"; }
+
+				return isString && chain.isOnlyPlus(0, chain.ops.size()) ? "string" : "";
+			}
+
+			default:
+				return "";
+		}
+	}
+
+	// Adds the names of the variables declared in the block (and the blocks within it)
+	static void addDeclaredNames(LX::Parser::AST& body, std::unordered_set<std::string>& names)
+	{
+		using namespace LX::Parser;
+
+		for (std::unique_ptr<ASTNode>& statement : body)
+		{
+			if (statement == nullptr) { continue; }
+
+			if (statement->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+			{
+				names.insert(static_cast<VariableDeclaration*>(statement.get())->name.name);
+			}
+
+			else if (statement->type == ASTNode::NodeType::DESTRUCTURING_DECLARATION)
+			{
+				for (std::unique_ptr<VariableDeclaration>& var : static_cast<DestructuringDeclaration*>(statement.get())->vars)
+				{
+					names.insert(var->name.name);
+				}
+			}
+
+			else if (statement->type == ASTNode::NodeType::IF_STATEMENT)
+			{
+				for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+				{
+					addDeclaredNames(branch->body, names);
+				}
+			}
+
+			else if (statement->type == ASTNode::NodeType::LOOP_STATEMENT)
+			{
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(statement.get());
+
+				if (loopStatement->init != nullptr && loopStatement->init->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+				{
+					names.insert(static_cast<VariableDeclaration*>(loopStatement->init.get())->name.name);
+				}
+
+				addDeclaredNames(loopStatement->body, names);
+			}
+		}
+	}
+
+	static bool isTailCall(const Translator& translator, LX::Parser::FunctionDeclaration& func, LX::Parser::ReturnStatement* returnStatement)
+	{
+		using namespace LX::Parser;
+
+		ASTNode* expr = returnStatement->expr.get();
+
+		if (expr == nullptr || expr->type != ASTNode::NodeType::FUNCTION_CALL) { return false; }
+
+		FunctionCall* call = static_cast<FunctionCall*>(expr);
+
+		if (call->funcName.name != func.name.name || call->args.size() != func.args.size()) { return false; }
+
+		for (size_t i = 0; i < call->args.size(); i++)
+		{
+			const VariableDeclaration* param = static_cast<const VariableDeclaration*>(func.args[i].get());
+
+			if (isSameParameter(call->args[i].get(), param)) { continue; }
+
+			// Const and reference parameters cannot be given a new value
+			if (param->isConst() || param->isReference() || param->isPointer()) { return false; }
+
+			if (argumentType(translator, call->args[i].get()) != param->varType.name) { return false; }
+		}
+
+		return true;
+	}
+
+	// Adds the tail calls of the block (and the if statements within it)
+	// Returns inside a loop are left as calls as the continue would go to the start of that loop instead
+	static void addTailCalls(const Translator& translator, LX::Parser::FunctionDeclaration& func, LX::Parser::AST& body, TailCalls& tailCalls)
+	{
+		using namespace LX::Parser;
+
+		for (std::unique_ptr<ASTNode>& statement : body)
+		{
+			if (statement == nullptr) { continue; }
+
+			if (statement->type == ASTNode::NodeType::RETURN_STATEMENT && isTailCall(translator, func, static_cast<ReturnStatement*>(statement.get())))
+			{
+				tailCalls.insert(static_cast<ReturnStatement*>(statement.get()));
+			}
+
+			else if (statement->type == ASTNode::NodeType::IF_STATEMENT)
+			{
+				for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+				{
+					addTailCalls(translator, func, branch->body, tailCalls);
+				}
+			}
+		}
+	}
+
+	TailCalls findTailCalls(const Translator& translator, LX::Parser::FunctionDeclaration& func)
+	{
+		TailCalls tailCalls;
+
+		// A variable with the same name as a parameter would be given the value instead of the parameter
+		std::unordered_set<std::string> declared;
+		addDeclaredNames(func.body, declared);
+
+		for (const std::unique_ptr<LX::Parser::ASTNode>& arg : func.args)
+		{
+			if (declared.find(static_cast<LX::Parser::VariableDeclaration*>(arg.get())->name.name) != declared.end()) { return tailCalls; }
+		}
+
+		addTailCalls(translator, func, func.body, tailCalls);
+
+		return tailCalls;
+	}
+
+	void assembleTailCall(Translator& translator, LX::Parser::ReturnStatement* returnStatement)
+	{
+		using namespace LX::Parser;
+
+		FunctionCall* call = static_cast<FunctionCall*>(returnStatement->expr.get());
+		const FunctionDeclaration& func = *translator.function;
+
+		// Parameters that are given a different value
+		std::vector<size_t> changed;
+
+		for (size_t i = 0; i < call->args.size(); i++)
+		{
+			if (isSameParameter(call->args[i].get(), static_cast<VariableDeclaration*>(func.args[i].get())) == false)
+			{
+				changed.push_back(i);
+			}
+		}
+
+		// A single parameter can be assigned directly
+		if (changed.size() == 1)
+		{
+			translator.out << static_cast<VariableDeclaration*>(func.args[changed[0]].get())->name.name << " = ";
+			translator.assembleNode(call->args[changed[0]].get());
+			translator.out << ";\n";
+		}
+
+		// Every argument is calculated before any parameter changes as they can use the old values of the parameters
+		else if (changed.empty() == false)
+		{
+			translator.out << "{\n";
+
+			for (size_t i : changed)
+			{
+				VariableDeclaration* param = static_cast<VariableDeclaration*>(func.args[i].get());
+
+				translator.out << variableType(translator, param) << " lx_next_" << param->name.name << " = ";
+				translator.assembleNode(call->args[i].get());
+				translator.out << ";\n";
+			}
+
+			for (size_t i : changed)
+			{
+				VariableDeclaration* param = static_cast<VariableDeclaration*>(func.args[i].get());
+
+				if (param->varType.name == "string")
+				{
+					translator.includes.insert("utility");
+					translator.out << param->name.name << " = std::move(lx_next_" << param->name.name << ");\n";
+				}
+
+				else
+				{
+					translator.out << param->name.name << " = lx_next_" << param->name.name << ";\n";
+				}
+			}
+
+			translator.out << "}\n";
+		}
+
+		translator.out << "continue;";
+	}
+}
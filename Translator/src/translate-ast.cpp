@@ -41,35 +41,94 @@
 #include <common.h>
 
 #include <translator.h>
+#include <string-concat.h>
 
 namespace LX::Translator
 {
-	void assembleIdentifier(Translator& translator, LX::Parser::ASTNode* node)
+	std::string variableType(Translator& translator, const LX::Parser::VariableDeclaration* varDecl)
 	{
-		translator.out << dynamic_cast<LX::Parser::Identifier*>(node)->name;
+		const std::string& name = varDecl->varType.name;
+
+		if (name == "string")
+		{
+			translator.includes.insert("string");
+			return "std::string";
+		}
+
+		if (name == "f32") { return "float"; }
+		if (name == "f64") { return "double"; }
+
+		// Fixed width integers (i8 to i64) are the <cstdint> types with the same width
+		if (name.size() > 1 && name[0] == 'i' && name != "int")
+		{
+			translator.includes.insert("cstdint");
+			return (varDecl->isUnsigned() ? "std::uint" : "std::int") + name.substr(1) + "_t";
+		}
+
+		return name;
+	}
+
+	void assembleIdentifier(Translator& translator, LX::Parser::Identifier* identifier)
+	{
+		if (translator.movableUses.find(identifier) != translator.movableUses.end())
+		{
+			translator.includes.insert("utility");
+			translator.out << "std::move(" << identifier->name << ")";
+			return;
+		}
+
+		translator.out << identifier->name;
+
+		// Numbers too big for a signed 64 bit integer can only be u64 values so are marked as unsigned
+		const std::string& name = identifier->name;
+
+		if (name.size() >= 19 && std::all_of(name.begin(), name.end(), [](char c) { return c >= '0' && c <= '9'; }))
+		{
+			if (name.size() > 19 || name > "9223372036854775807") { translator.out << "u"; }
+		}
 	}
 
-	void assembleVariableDeclaration(Translator& translator, LX::Parser::ASTNode* node)
+	// Returns true if the node is a number literal (numbers are stored as identifiers)
+	static bool isNumberLiteral(const LX::Parser::ASTNode* node)
 	{
-		LX::Parser::VariableDeclaration* varDecl = dynamic_cast<LX::Parser::VariableDeclaration*>(node);
+		if (node == nullptr || node->type != LX::Parser::ASTNode::NodeType::IDENTIFIER) { return false; }
+
+		const std::string& name = static_cast<const LX::Parser::Identifier*>(node)->name;
+		size_t start = (name.size() > 1 && name[0] == '-') ? 1 : 0;
 
+		return name.empty() == false && name[start] >= '0' && name[start] <= '9';
+	}
+
+	void assembleVariableDeclaration(Translator& translator, LX::Parser::VariableDeclaration* varDecl)
+	{
 		// Variable modifiers
 
-		if (varDecl->isConst()) { translator.out << "const "; }
+		// Static const strings that are only printed, joined or compared are views of the literal
+		bool isView = translator.viewableConstants.find(varDecl->name.name) != translator.viewableConstants.end();
+
+		// Static constants with a number as their value are created at compile time
+		bool isConstexpr = isView || (varDecl->isStatic() && varDecl->isConst() && varDecl->varType.name != "string" && varDecl->val != nullptr && isNumberLiteral(varDecl->val->val.get()));
+
+		if (varDecl->isStatic()) { translator.out << "static "; }
+
+		if (isConstexpr) { translator.out << "constexpr "; }
+		else if (varDecl->isConst()) { translator.out << "const "; }
 
 		// Variable type
 
-		if (varDecl->varType.name == "string")
+		if (isView)
 		{
-			translator.includes.insert("string");
-			translator.out << "std::string ";
+			translator.includes.insert("string_view");
+			translator.out << "std::string_view";
 		}
 
 		else
 		{
-			translator.out << varDecl->varType.name << " ";
+			translator.out << variableType(translator, varDecl);
 		}
 
+		translator.out << (varDecl->isReference() ? "& " : " ");
+
 		// Variable name
 
 		assembleIdentifier(translator, &varDecl->name);
@@ -80,12 +139,47 @@ namespace LX::Translator
 		{
 			assembleAssignment(translator, varDecl->val.get());
 		}
+
+		// Without a value nothing else ends the declaration
+		else
+		{
+			translator.out << ";";
+		}
 	}
 
-	void assembleAssignment(Translator& translator, LX::Parser::ASTNode* node)
+	void assembleDestructuringDeclaration(Translator& translator, LX::Parser::DestructuringDeclaration* destructuring)
 	{
-		LX::Parser::Assignment* assignment = dynamic_cast<LX::Parser::Assignment*>(node);
+		// The values are stored in a temporary before being given to the variables
+		// A structured binding would use the types the function returns instead of the ones the variables were declared with
+		std::string tuple = "lx_tuple_" + std::to_string(translator.destructuringCount++);
+
+		// The temporary is only static if all of the variables are (the parser does not allow them to be mixed)
+		// Otherwise the non-static variables would be moved out of it again on every call
+		bool isStatic = std::all_of(destructuring->vars.begin(), destructuring->vars.end(), [](const std::unique_ptr<LX::Parser::VariableDeclaration>& var) { return var->isStatic(); });
+
+		translator.includes.insert("utility");
+		translator.out << (isStatic ? "static auto " : "auto ") << tuple << " = ";
+		translator.assembleNode(destructuring->val.get());
+		translator.out << ";";
 
+		for (size_t i = 0; i < destructuring->vars.size(); i++)
+		{
+			LX::Parser::VariableDeclaration* var = destructuring->vars[i].get();
+
+			if (var->isStatic()) { translator.out << "static "; }
+			if (var->isConst()) { translator.out << "const "; }
+
+			translator.out << variableType(translator, var) << (var->isReference() ? "& " : " ");
+			assembleIdentifier(translator, &var->name);
+
+			// References refer to the value within the temporary so it cannot be moved from
+			if (var->isReference()) { translator.out << " = std::get<" << i << ">(" << tuple << ");"; }
+			else { translator.out << " = std::get<" << i << ">(std::move(" << tuple << "));"; }
+		}
+	}
+
+	void assembleAssignment(Translator& translator, LX::Parser::Assignment* assignment)
+	{
 		assembleIdentifier(translator, &assignment->name);
 
 		translator.out << " = ";
@@ -128,19 +222,37 @@ namespace LX::Translator
 		return operatorMap.at(op);
 	}
 
-	void assembleOperation(Translator& translator, LX::Parser::ASTNode* node)
+	void assembleOperation(Translator& translator, LX::Parser::Operation* operation)
 	{
-		LX::Parser::Operation* operation = dynamic_cast<LX::Parser::Operation*>(node);
+		FlatOperation chain(operation);
+
+		// Each sum of the chain is checked for strings that can be joined by a single call
+		for (size_t start = 0; start < chain.operands.size();)
+		{
+			size_t end = chain.endOfSum(start);
 
-		translator.assembleNode(operation->lhs.get());
-		translator.out << " " << getOperator(operation->op) << " ";
-		translator.assembleNode(operation->rhs.get());
+			if (assembleConcat(translator, chain, start, end) == false)
+			{
+				for (size_t i = start; i < end; i++)
+				{
+					translator.assembleNode(chain.operands[i]);
+					translator.out << " " << getOperator(chain.ops[i]) << " ";
+				}
+
+				translator.assembleNode(chain.operands[end]);
+			}
+
+			if (end < chain.ops.size())
+			{
+				translator.out << " " << getOperator(chain.ops[end]) << " ";
+			}
+
+			start = end + 1;
+		}
 	}
 
-	void assembleUnaryOperation(Translator& translator, LX::Parser::ASTNode* node)
+	void assembleUnaryOperation(Translator& translator, LX::Parser::UnaryOperation* unaryOperation)
 	{
-		LX::Parser::UnaryOperation* unaryOperation = dynamic_cast<LX::Parser::UnaryOperation*>(node);
-
 		if (unaryOperation->side == LX::Parser::UnaryOperation::Sided::LEFT)
 		{
 			translator.out << getOperator(unaryOperation->op) << " ";
@@ -154,16 +266,17 @@ namespace LX::Translator
 		}
 	}
 
-	void assembleFunctionCall(Translator& translator, LX::Parser::ASTNode* node)
+	void assembleFunctionCall(Translator& translator, LX::Parser::FunctionCall* functionCall)
 	{
-		LX::Parser::FunctionCall* functionCall = dynamic_cast<LX::Parser::FunctionCall*>(node);
-
-		if (Core::funcMap.find(functionCall->funcName.name) != Core::funcMap.end())
+		if (auto it = Core::funcMap.find(functionCall->funcName.name); it != Core::funcMap.end())
 		{
-			Core::funcMap[functionCall->funcName.name](functionCall, translator);
+			it->second(functionCall, translator);
 			return;
 		}
 
+		// The declaration of the function will need to be included
+		translator.callees.insert(functionCall->funcName.name);
+
 		assembleIdentifier(translator, &functionCall->funcName);
 		translator.out << "(";
 
@@ -179,24 +292,34 @@ namespace LX::Translator
 		translator.out << ")";
 	}
 
-	void assembleStringLiteral(Translator& translator, LX::Parser::ASTNode* node)
+	void assembleStringLiteral(Translator& translator, LX::Parser::StringLiteral* stringLiteral)
 	{
-		translator.out << "\"" << dynamic_cast<LX::Parser::StringLiteral*>(node)->value << "\"";
+		translator.out << "\"" << stringLiteral->value << "\"";
 	}
 
-	void assembleBracketedExpression(Translator& translator, LX::Parser::ASTNode* node)
+	void assembleBracketedExpression(Translator& translator, LX::Parser::BracketedExpression* bracketedExpression)
 	{
-		LX::Parser::BracketedExpression* bracketedExpression = dynamic_cast<LX::Parser::BracketedExpression*>(node);
-
 		translator.out << "(";
 		translator.assembleNode(bracketedExpression->expr.get());
 		translator.out << ")";
 	}
 
-	void assembleIfStatement(Translator& translator, LX::Parser::ASTNode* node)
+	void assembleTupleExpression(Translator& translator, LX::Parser::TupleExpression* tuple)
 	{
-		LX::Parser::IfStatement* ifStatement = dynamic_cast<LX::Parser::IfStatement*>(node);
+		translator.out << "{ ";
 
+		for (size_t i = 0; i < tuple->values.size(); i++)
+		{
+			if (i != 0) { translator.out << ", "; }
+
+			translator.assembleNode(tuple->values[i].get());
+		}
+
+		translator.out << " }";
+	}
+
+	void assembleIfStatement(Translator& translator, LX::Parser::IfStatement* ifStatement)
+	{
 		while (ifStatement != nullptr)
 		{
 			switch (ifStatement->type)
@@ -228,27 +351,76 @@ namespace LX::Translator
 			}
 
 			translator.out << "\n{\n";
-			for (const std::unique_ptr<LX::Parser::ASTNode>& statement : ifStatement->body)
-			{
-				translator.assembleNode(statement.get());
-			}
+			translator.assembleBlock(ifStatement->body);
 			translator.out << "\n}\n";
 
-			if (ifStatement->next != nullptr)
+			ifStatement = ifStatement->next.get();
+		}
+	}
+
+	void assembleLoopStatement(Translator& translator, LX::Parser::LoopStatement* loopStatement)
+	{
+		using namespace LX::Parser;
+
+		if (loopStatement->loopType == LoopStatement::LoopType::WHILE)
+		{
+			translator.out << "while (";
+			translator.assembleNode(loopStatement->condition.get());
+			translator.out << ")";
+		}
+
+		else
+		{
+			translator.out << "for (";
+
+			// Declarations and assignments end themselves (other statements do not)
+			ASTNode* init = loopStatement->init.get();
+
+			if (init != nullptr) { translator.assembleNode(init); }
+
+			bool isEnded = init != nullptr && (init->type == ASTNode::NodeType::ASSIGNMENT || init->type == ASTNode::NodeType::VARIABLE_DECLARATION);
+
+			translator.out << (isEnded ? " " : "; ");
+
+			if (loopStatement->condition != nullptr) { translator.assembleNode(loopStatement->condition.get()); }
+
+			translator.out << "; ";
+
+			// An assignment would end itself with a semicolon which cannot be in the brackets
+			ASTNode* step = loopStatement->step.get();
+
+			if (step != nullptr && step->type == ASTNode::NodeType::ASSIGNMENT)
 			{
-				ifStatement = dynamic_cast<LX::Parser::IfStatement*>(ifStatement->next.get());
+				assembleIdentifier(translator, &static_cast<Assignment*>(step)->name);
+				translator.out << " = ";
+				translator.assembleNode(static_cast<Assignment*>(step)->val.get());
 			}
 
-			else
+			else if (step != nullptr)
 			{
-				ifStatement = nullptr;
+				translator.assembleNode(step);
 			}
+
+			translator.out << ")";
 		}
+
+		translator.out << "\n{\n";
+		translator.assembleBlock(loopStatement->body);
+		translator.out << "\n}\n";
 	}
 
-	void assembleReturnStatement(Translator& translator, LX::Parser::ASTNode* node)
+	void assembleJumpStatement(Translator& translator, LX::Parser::JumpStatement* jumpStatement)
 	{
-		LX::Parser::ReturnStatement* returnStatement = dynamic_cast<LX::Parser::ReturnStatement*>(node);
+		translator.out << (jumpStatement->jumpType == LX::Parser::JumpStatement::JumpType::BREAK ? "break;" : "continue;");
+	}
+
+	void assembleReturnStatement(Translator& translator, LX::Parser::ReturnStatement* returnStatement)
+	{
+		if (translator.tailCalls.find(returnStatement) != translator.tailCalls.end())
+		{
+			assembleTailCall(translator, returnStatement);
+			return;
+		}
 
 		translator.out << "return";
 
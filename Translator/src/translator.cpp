@@ -41,106 +41,317 @@
 #include <common.h>
 
 #include <lx-core.h>
+#include <translate-ast.h>
+#include <output.h>
 
 namespace LX::Translator
 {
-	std::vector<std::string> Translator::funcList;
-	std::vector<std::string> Translator::funcHeaders;
+	// Rough size of the C++ a top level statement (including any nested blocks) is translated to
+	static constexpr size_t BYTES_PER_STATEMENT = 96;
 
 	void Translator::assembleNode(LX::Parser::ASTNode* node)
 	{
-		nodeTranslators[node->type](*this, node);
+		using namespace LX::Parser;
+
+		// The node type already says what class the node is so static_cast is safe here
+		switch (node->type)
+		{
+			case ASTNode::NodeType::IDENTIFIER:
+				assembleIdentifier(*this, static_cast<Identifier*>(node));
+				return;
+
+			case ASTNode::NodeType::VARIABLE_DECLARATION:
+				assembleVariableDeclaration(*this, static_cast<VariableDeclaration*>(node));
+				return;
+
+			case ASTNode::NodeType::DESTRUCTURING_DECLARATION:
+				assembleDestructuringDeclaration(*this, static_cast<DestructuringDeclaration*>(node));
+				return;
+
+			case ASTNode::NodeType::ASSIGNMENT:
+				assembleAssignment(*this, static_cast<Assignment*>(node));
+				return;
+
+			case ASTNode::NodeType::OPERATION:
+				assembleOperation(*this, static_cast<Operation*>(node));
+				return;
+
+			case ASTNode::NodeType::UNARY_OPERATION:
+				assembleUnaryOperation(*this, static_cast<UnaryOperation*>(node));
+				return;
+
+			case ASTNode::NodeType::FUNCTION_CALL:
+				assembleFunctionCall(*this, static_cast<FunctionCall*>(node));
+				return;
+
+			case ASTNode::NodeType::STRING_LITERAL:
+				assembleStringLiteral(*this, static_cast<StringLiteral*>(node));
+				return;
+
+			case ASTNode::NodeType::BRACKETED_EXPRESSION:
+				assembleBracketedExpression(*this, static_cast<BracketedExpression*>(node));
+				return;
+
+			case ASTNode::NodeType::TUPLE_EXPRESSION:
+				assembleTupleExpression(*this, static_cast<TupleExpression*>(node));
+				return;
+
+			case ASTNode::NodeType::IF_STATEMENT:
+				assembleIfStatement(*this, static_cast<IfStatement*>(node));
+				return;
+
+			case ASTNode::NodeType::LOOP_STATEMENT:
+				assembleLoopStatement(*this, static_cast<LoopStatement*>(node));
+				return;
+
+			case ASTNode::NodeType::JUMP_STATEMENT:
+				assembleJumpStatement(*this, static_cast<JumpStatement*>(node));
+				return;
+
+			case ASTNode::NodeType::RETURN_STATEMENT:
+				assembleReturnStatement(*this, static_cast<ReturnStatement*>(node));
+				return;
+
+			default:
+				assembleUndefined(*this, node);
+				return;
+		}
+	}
+
+	// Returns the call if the node is a call to the core print function (or nullptr)
+	static LX::Parser::FunctionCall* asPrintCall(LX::Parser::ASTNode* node)
+	{
+		if (node == nullptr || node->type != LX::Parser::ASTNode::NodeType::FUNCTION_CALL) { return nullptr; }
+
+		LX::Parser::FunctionCall* call = static_cast<LX::Parser::FunctionCall*>(node);
+
+		return call->funcName.name == "print" ? call : nullptr;
 	}
 
-	void Translator::assemble(LX::Parser::FunctionDeclaration& AST, const std::string outputDir, const std::string lx_fileName)
+	// Returns true if the statement is an expression on its own
+	static bool isExpressionStatement(LX::Parser::ASTNode* statement)
 	{
-		// Adds the function to the function list
-		std::string funcDecl = AST.returnTypes[0].name + " " + AST.name.name + "(";
+		using NodeType = LX::Parser::ASTNode::NodeType;
 
-		for (int i = 0; i < AST.args.size(); i++)
+		if (statement == nullptr) { return false; }
+
+		switch (statement->type)
 		{
-			if (i != 0) { funcDecl += ", "; }
+			case NodeType::IDENTIFIER:
+			case NodeType::OPERATION:
+			case NodeType::UNARY_OPERATION:
+			case NodeType::FUNCTION_CALL:
+			case NodeType::STRING_LITERAL:
+			case NodeType::BRACKETED_EXPRESSION:
+				return true;
 
-			LX::Parser::VariableDeclaration* arg = static_cast<LX::Parser::VariableDeclaration*>(AST.args[i].get());
+			default:
+				return false;
+		}
+	}
 
-			if (arg->isConst()) { funcDecl += "const "; }
+	void Translator::assembleBlock(std::vector<std::unique_ptr<LX::Parser::ASTNode>>& body)
+	{
+		std::vector<LX::Parser::FunctionCall*> prints;
+
+		for (size_t i = 0; i < body.size(); i++)
+		{
+			// Collects the run of prints starting at the statement
+			while (i < body.size() && asPrintCall(body[i].get()) != nullptr)
+			{
+				prints.push_back(asPrintCall(body[i].get()));
+				i++;
+			}
+
+			if (prints.empty() == false)
+			{
+				Core::printFunctions(prints, *this);
+				prints.clear();
+			}
+
+			if (i < body.size())
+			{
+				assembleNode(body[i].get());
+
+				// Statements that are expressions (such as x += 1) are not ended by their nodes
+				if (isExpressionStatement(body[i].get())) { out << ";"; }
+			}
+		}
+	}
+
+	// Adds the type of every variable declared in the block (and the blocks and loops within it)
+	static void collectVariableTypes(std::vector<std::unique_ptr<LX::Parser::ASTNode>>& body, std::unordered_map<std::string, std::string>& types)
+	{
+		using namespace LX::Parser;
+
+		for (std::unique_ptr<ASTNode>& statement : body)
+		{
+			if (statement == nullptr) { continue; }
+
+			if (statement->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+			{
+				VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(statement.get());
+
+				// Variables with the same name can hide each other so the type is only known if they all match
+				auto [it, inserted] = types.try_emplace(varDecl->name.name, varDecl->varType.name);
+				if (inserted == false && it->second != varDecl->varType.name) { it->second.clear(); }
+			}
+
+			else if (statement->type == ASTNode::NodeType::DESTRUCTURING_DECLARATION)
+			{
+				for (std::unique_ptr<VariableDeclaration>& var : static_cast<DestructuringDeclaration*>(statement.get())->vars)
+				{
+					auto [it, inserted] = types.try_emplace(var->name.name, var->varType.name);
+					if (inserted == false && it->second != var->varType.name) { it->second.clear(); }
+				}
+			}
 
-			if (arg->varType.name == "string")
+			else if (statement->type == ASTNode::NodeType::IF_STATEMENT)
 			{
-				includes.insert("string");
-				funcDecl += "std::string ";
+				for (IfStatement* branch = static_cast<IfStatement*>(statement.get()); branch != nullptr; branch = branch->next.get())
+				{
+					collectVariableTypes(branch->body, types);
+				}
 			}
 
-			else
+			else if (statement->type == ASTNode::NodeType::LOOP_STATEMENT)
 			{
-				funcDecl += arg->varType.name + " ";
+				LoopStatement* loopStatement = static_cast<LoopStatement*>(statement.get());
+
+				if (loopStatement->init != nullptr && loopStatement->init->type == ASTNode::NodeType::VARIABLE_DECLARATION)
+				{
+					VariableDeclaration* varDecl = static_cast<VariableDeclaration*>(loopStatement->init.get());
+
+					auto [it, inserted] = types.try_emplace(varDecl->name.name, varDecl->varType.name);
+					if (inserted == false && it->second != varDecl->varType.name) { it->second.clear(); }
+				}
+
+				collectVariableTypes(loopStatement->body, types);
 			}
+		}
+	}
+
+	// Returns the C++ type the function returns
+	// Multiple values are returned together as a std::pair (or a std::tuple for more than two)
+	// Destructuring declarations store it in a temporary and take each value out with std::get
+	static std::string returnType(const LX::Parser::FunctionDeclaration& AST, std::set<std::string>& includes)
+	{
+		for (const LX::Parser::Identifier& type : AST.returnTypes)
+		{
+			if (type.name == "std::string") { includes.insert("string"); }
+			if (type.name.rfind("std::int", 0) == 0 || type.name.rfind("std::uint", 0) == 0) { includes.insert("cstdint"); }
+		}
+
+		if (AST.returnTypes.size() == 1) { return AST.returnTypes[0].name; }
+
+		std::string type;
+
+		if (AST.returnTypes.size() == 2)
+		{
+			includes.insert("utility");
+			type = "std::pair<";
+		}
+
+		else
+		{
+			includes.insert("tuple");
+			type = "std::tuple<";
+		}
+
+		for (size_t i = 0; i < AST.returnTypes.size(); i++)
+		{
+			if (i != 0) { type += ", "; }
+
+			type += AST.returnTypes[i].name;
+		}
+
+		return type + ">";
+	}
+
+	TranslatedFunction Translator::assemble(LX::Parser::FunctionDeclaration& AST, const std::string& lx_fileName)
+	{
+		// Creates the function declaration
+		std::string funcDecl = returnType(AST, includes) + " " + AST.name.name + "(";
+
+		for (int i = 0; i < AST.args.size(); i++)
+		{
+			if (i != 0) { funcDecl += ", "; }
+
+			LX::Parser::VariableDeclaration* arg = static_cast<LX::Parser::VariableDeclaration*>(AST.args[i].get());
+
+			if (arg->isConst()) { funcDecl += "const "; }
+
+			funcDecl += variableType(*this, arg);
+			funcDecl += arg->isReference() ? "& " : " ";
 
 			funcDecl += arg->name.name;
 		}
 
 		funcDecl += ")";
 
-		// Adds the function declaration to the header list
-		funcHeaders.push_back(funcDecl);
+		// Anything included so far is needed by the declaration
+		std::set<std::string> headerIncludes = includes;
 
-		// Adds the function declaration to the output stream
-		out << funcDecl << "\n{\n";
+		// Reserves enough space for most functions so the output is a single chunk that can be moved into the result
+		out.reserve(funcDecl.size() + AST.body.size() * BYTES_PER_STATEMENT + 8);
+
+		movableUses = findMovableUses(AST);
+		viewableConstants = findViewableConstants(AST);
 
-		for (std::unique_ptr<LX::Parser::ASTNode>& node : AST.body)
+		for (std::unique_ptr<LX::Parser::ASTNode>& arg : AST.args)
 		{
-			assembleNode(node.get());
+			LX::Parser::VariableDeclaration* param = static_cast<LX::Parser::VariableDeclaration*>(arg.get());
+			variableTypes[param->name.name] = param->varType.name;
 		}
 
-		out << "}\n";
-		
-		// Creates the function .cpp filename
-		std::string fileName = outputDir + "/" + lx_fileName + "_" + AST.name.name + "-f" + ".cpp";
+		collectVariableTypes(AST.body, variableTypes);
+
+		function = &AST;
+		tailCalls = findTailCalls(*this, AST);
 
-		// Check if the file already exists within the function list (meaning it is an overloaded function)
-		if (std::find(funcList.begin(), funcList.end(), fileName) != funcList.end())
+		// Adds the function declaration to the output
+		out << funcDecl << "\n{\n";
+
+		// Tail calls go back to the start of the body instead of calling the function again
+		if (tailCalls.empty() == false)
 		{
-			// If it is, add a number to the end of the file name
-			int i = 1;
-			while (std::find(funcList.begin(), funcList.end(), fileName) != funcList.end())
-			{
-				fileName = outputDir + "/" + lx_fileName + "_" + AST.name.name + "-f" + std::to_string(i) + ".cpp";
-				i++;
-			}
+			out << "while (true)\n{\n";
+			assembleBlock(AST.body);
+			out << "}\n";
 		}
 
-		// Adds the file to the function list
-		funcList.push_back(fileName);
+		else
+		{
+			assembleBlock(AST.body);
+		}
 
-		// Combines the includes
-		std::ostringstream includeStream;
-		for (const std::string& include : includes) { includeStream << "#include <" << include << ">\n"; }
-		includeStream << "#include <functions.h>\n\n";
+		out << "}\n";
 
-		// Writes to the file
-		std::ofstream file(fileName);
+		// Moves the output into the result
+		TranslatedFunction result;
+		result.name = AST.name.name;
+		result.lx_fileName = lx_fileName;
+		result.header = std::move(funcDecl);
+		result.headerIncludes = std::move(headerIncludes);
+		result.includes = std::move(includes);
+		result.callees = std::move(callees);
+		result.source = out.take();
 
-		file << includeStream.str();
-		file << out.str();
+		return result;
 	}
-}
-
-#include <translate-ast.h>
 
-namespace LX::Translator
-{
-	std::unordered_map<LX::Parser::ASTNode::NodeType, std::function<void(Translator&, LX::Parser::ASTNode*)>> Translator::nodeTranslators =
+	void translateFile(LX::Parser::FileAST& AST, OutputRegistry& registry, const std::string& lx_fileName)
 	{
-		{ LX::Parser::ASTNode::NodeType::IDENTIFIER,					 assembleIdentifier					},
-		{ LX::Parser::ASTNode::NodeType::VARIABLE_DECLARATION,			 assembleVariableDeclaration		},
-		{ LX::Parser::ASTNode::NodeType::ASSIGNMENT,					 assembleAssignment					},
-		{ LX::Parser::ASTNode::NodeType::OPERATION,						 assembleOperation					},
-		{ LX::Parser::ASTNode::NodeType::UNARY_OPERATION,				 assembleUnaryOperation				},
-		{ LX::Parser::ASTNode::NodeType::FUNCTION_CALL,					 assembleFunctionCall				},
-		{ LX::Parser::ASTNode::NodeType::STRING_LITERAL,				 assembleStringLiteral				},
-		{ LX::Parser::ASTNode::NodeType::BRACKETED_EXPRESSION,			 assembleBracketedExpression		},
-		{ LX::Parser::ASTNode::NodeType::IF_STATEMENT,					 assembleIfStatement				},
-		{ LX::Parser::ASTNode::NodeType::RETURN_STATEMENT,				 assembleReturnStatement			},
-		{ LX::Parser::ASTNode::NodeType::UNDEFINED,						 assembleUndefined					}
-	};
+		// Each function is translated by its own translator so they share no state
+		std::vector<TranslatedFunction> results(AST.functions.size());
+
+		LX::Thread::parallelFor(AST.functions.size(), [&](size_t i)
+		{
+			Translator translator;
+			results[i] = translator.assemble(AST.functions[i], lx_fileName);
+		});
+
+		// Merges the results in declaration order
+		registry.add(results);
+	}
 }
\ No newline at end of file